@@ -13,56 +13,34 @@
 #include "glm\gtc\matrix_transform.hpp"
 #include "glm\gtx\rotate_vector.hpp"
 #include "..\SOIL\src\SOIL.h"
+#include "World.h"
+#include "Scenario.h"
+#include "Replay.h"
+#include "InstancedBatches.h"
+#include "StaticMesh.h"
+#include "StreamRing.h"
+#include "TextureArray.h"
+#include "JobSystem.h"
+#include "Logger.h"
+#include "Benchmarks.h"
 #include <vector>
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <array>
+#include <memory>
 
 void renderBitmapString(float x, float y, void* font, const char* string);
+void reportReplay(const Replay& replay, const World& w, double totalMs, int frames);
 
 using namespace std;
 
-// === Game Object ===
-enum GameObject_Type {
-    PLAYER,
-    ENEMY,
-    BULLET,
-    OBSTACLE
-};
-
-struct GameObject {
-    glm::vec3 location;
-    glm::vec3 rotation;
-    glm::vec3 scale;
-    glm::vec3 moving_direction;
-    GLfloat velocity;
-    GLfloat collider_dimension;
-    int living_time;
-    int life_span;
-    int type;
-    bool isAlive;
-    bool isCollided;
-    GLuint textureID;
-    int lastShotTime; // For enemy shooting cooldown
-    int owner; // 0 = player, 1 = enemy
-
-
-};
-
 // === Globals ===
-std::vector<GameObject> sceneGraph;
-std::vector<GameObject> enemyList;
+World world; // the match shown in the window
 GLuint enemyTextureID;
-float spawnTimer = 0.0f;
-float spawnInterval = 3000.0f;
-const int enemyShootCooldown = 2000; // milliseconds between shots
-int playerHealth = 100;
-bool gameWon = false;
-bool gameOver = false;
-int playerScore = 0;
-
 
-const int Num_Obstacles = 20;
-float obstacle_data[Num_Obstacles][3];
+JobSystem jobs; // worker pool for the per-chunk passes
 
 GLuint location;
 GLuint cam_mat_location;
@@ -71,18 +49,33 @@ GLuint texture[2];
 GLuint Buffers[2];
 
 glm::mat4 model_view;
-glm::vec3 unit_z_vector = glm::vec3(0, 0, 1);
-glm::vec3 cam_pos = glm::vec3(0.0f, 0.0f, 0.8f);
-glm::vec3 forward_vector = glm::vec3(1, 1, 0);
-glm::vec3 looking_dir_vector = glm::vec3(1, 1, 0);
-glm::vec3 up_vector = unit_z_vector;
-glm::vec3 side_vector = glm::cross(up_vector, forward_vector);
-
-int x0 = 0, y_0 = 0;
-int oldTimeSinceStart = 0;
-int deltaTime;
-float travel_speed = 300.0f;
-float mouse_sensitivity = 0.01f;
+
+float deltaTime; // real milliseconds since the previous frame
+
+// === Fixed-timestep simulation ===
+const int maxTicksPerFrame = 10;    // catch-up limit after a stall, so one slow frame cannot snowball
+double simAccumulator = 0.0;        // real time not yet consumed by ticks
+float renderAlpha = 0.0f;           // position of the rendered frame between the last two ticks (0..1)
+std::chrono::steady_clock::time_point lastFrameTime;
+
+// === Input replay ===
+Replay recording;                   // filled in while the window runs with --record
+std::string recordPath;             // where the recording goes on exit; empty when not recording
+Replay playback;                    // drives the window with --replay ... --render
+bool playingBack = false;
+size_t nextPlaybackInput = 0;
+int playbackFrames = 0;
+double playbackMs = 0.0;
+
+// === Object rendering ===
+InstancedBatches cubes;             // obstacles and bullets
+InstancedBatches enemies;
+StaticMesh pyramid;                 // the enemy mesh, uploaded once in init()
+StreamRing frameStream;             // per-frame instance data, mapped once; unused without buffer storage
+const size_t frameStreamBytes = 4 << 20;
+TextureArray objectTextures;        // crate and fire, so each instanced mesh is one bind and one draw call
+bool instancing = true;             // i switches back to one draw call per object
+int benchDrawObjects = 0;           // objects placed in view by --bench-draw; 0 = normal game
 
 const GLuint NumVertices = 28;
 
@@ -100,231 +93,57 @@ void drawCube(glm::vec3 scale, GLuint tex) {
     glDrawArrays(GL_QUADS, 4, 24);
 }
 
-void drawPyramid(glm::vec3 scale, GLuint tex) {
+void draw_level() {
+    glBindTexture(GL_TEXTURE_2D, texture[0]);
+    glDrawArrays(GL_QUADS, 0, 4);
     glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, tex);
-    //glColor4f(1.0f, 1.0f, 1.0f, 1.0f);  // Full brightness
-    glColor4ub(255, 255, 255, 255);  // Max out white/alpha
-
-
-    glPushMatrix();
-    glScalef(scale.x, scale.y, scale.z);
-
-    glBegin(GL_TRIANGLES);
-    // Front face
-    glTexCoord2f(0.5f, 1.0f); glVertex3f(0.0f, 1.0f, 0.0f);    // Top
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(-0.5f, 0.0f, 0.5f);   // Left
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(0.5f, 0.0f, 0.5f);    // Right
-
-    // Right face
-    glTexCoord2f(0.5f, 1.0f); glVertex3f(0.0f, 1.0f, 0.0f);
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(0.5f, 0.0f, 0.5f);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(0.5f, 0.0f, -0.5f);
-
-    // Back face
-    glTexCoord2f(0.5f, 1.0f); glVertex3f(0.0f, 1.0f, 0.0f);
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(0.5f, 0.0f, -0.5f);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(-0.5f, 0.0f, -0.5f);
-
-    // Left face
-    glTexCoord2f(0.5f, 1.0f); glVertex3f(0.0f, 1.0f, 0.0f);
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(-0.5f, 0.0f, -0.5f);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(-0.5f, 0.0f, 0.5f);
-    glEnd();
-
-    // Bottom face (optional — texture won't be visible often)
-    glBegin(GL_QUADS);
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(-0.5f, 0.0f, 0.5f);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(0.5f, 0.0f, 0.5f);
-    glTexCoord2f(1.0f, 1.0f); glVertex3f(0.5f, 0.0f, -0.5f);
-    glTexCoord2f(0.0f, 1.0f); glVertex3f(-0.5f, 0.0f, -0.5f);
-    glEnd();
-
-    glPopMatrix();
-}
-
-
-void spawnEnemy(std::vector<GameObject>& enemies, GLuint enemyTexture) {
-    float x = (rand() % 40 - 20);
-    float z = (rand() % 40 - 20);
-
-    // Prevent too-close spawn
-    float distanceToPlayer = glm::length(glm::vec2(x - cam_pos.x, z - cam_pos.z));
-    if (distanceToPlayer < 5.0f) return;
-
-    GameObject enemy;
-    enemy.scale = glm::vec3(1.0f);
-    enemy.location = glm::vec3(x, 0.5f, z);  // Set Y to 0.5 to rest on ground
-    enemy.rotation = glm::vec3(0.0f);
-    enemy.type = ENEMY;
-    enemy.velocity = 0.003f + (rand() % 5) * 0.001f;
-    enemy.isAlive = true;
-    enemy.collider_dimension = 0.9f;
-    enemy.isCollided = false;
-    enemy.living_time = 0;
-    enemy.life_span = -1;
-    enemy.textureID = enemyTexture;
-    enemy.moving_direction = glm::vec3(0.0f);
-    enemy.lastShotTime = glutGet(GLUT_ELAPSED_TIME);
-    enemies.push_back(enemy);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-}
 
-void checkCollisions() {
-    // First: Check sceneGraph vs sceneGraph (e.g., bullets hitting obstacles, etc.)
-    for (int i = 0; i < sceneGraph.size(); i++) {
-        for (int j = 0; j < sceneGraph.size(); j++) {
-            if (i != j && sceneGraph[i].isAlive && sceneGraph[j].isAlive &&
-                !(sceneGraph[i].type == OBSTACLE && sceneGraph[j].type == OBSTACLE)) {
-                GameObject& one = sceneGraph[i];
-                GameObject& two = sceneGraph[j];
-
-                bool collided = glm::abs(one.location.x - two.location.x) <= (one.collider_dimension / 2 + two.collider_dimension / 2) &&
-                    glm::abs(one.location.y - two.location.y) <= (one.collider_dimension / 2 + two.collider_dimension / 2) &&
-                    glm::abs(one.location.z - two.location.z) <= (one.collider_dimension / 2 + two.collider_dimension / 2);
-
-                if (collided) {
-                    one.isCollided = true;
-                    two.isCollided = true;
-                }
+    // Obstacles carry no texture of their own and get the crate, like every cube used to
+    if (instancing) {
+        cubes.clear();
+        for (size_t i = 0; i < world.sceneGraph.size(); i++) {
+            if (world.sceneGraph.isAlive[i] && !world.sceneGraph.isCollided[i]) {
+                GLuint tex = world.sceneGraph.textureID[i] != 0 ? world.sceneGraph.textureID[i] : texture[1];
+                cubes.add(glm::mix(world.sceneGraph.previous_location[i], world.sceneGraph.location[i], renderAlpha), world.sceneGraph.scale[i], tex);
             }
         }
+        cubes.draw(GL_QUADS, 4, 24);
     }
-    
-    for (int i = 0; i < sceneGraph.size(); i++) {
-        GameObject& bullet = sceneGraph[i];
-        if (!bullet.isAlive || bullet.type != BULLET || bullet.owner == 1) continue;
-
-        for (int j = 0; j < enemyList.size(); j++) {
-            GameObject& enemy = enemyList[j];
-            if (!enemy.isAlive) continue;
-
-            bool collided = glm::abs(bullet.location.x - enemy.location.x) <= (bullet.collider_dimension / 2 + enemy.collider_dimension / 2) &&
-                glm::abs(bullet.location.y - enemy.location.y) <= (bullet.collider_dimension / 2 + enemy.collider_dimension / 2) &&
-                glm::abs(bullet.location.z - enemy.location.z) <= (bullet.collider_dimension / 2 + enemy.collider_dimension / 2);
-
-            if (collided) {
-                bullet.isAlive = false;
-                enemy.isAlive = false;
-                bullet.isCollided = true;
-                enemy.isCollided = true;
-                playerScore += 20;
-                std::cout << "Bullet hit enemy!" << std::endl;
+    else {
+        for (size_t i = 0; i < world.sceneGraph.size(); i++) {
+            if (world.sceneGraph.isAlive[i] && !world.sceneGraph.isCollided[i]) {
+                model_view = glm::translate(glm::mat4(1.0), glm::mix(world.sceneGraph.previous_location[i], world.sceneGraph.location[i], renderAlpha));
+                glUniformMatrix4fv(location, 1, GL_FALSE, &model_view[0][0]);
+                drawCube(world.sceneGraph.scale[i], world.sceneGraph.textureID[i] != 0 ? world.sceneGraph.textureID[i] : texture[1]);
+                model_view = glm::mat4(1.0);
             }
         }
     }
-    // === Check if enemy bullets hit the player ===
-    for (GameObject& bullet : sceneGraph) {
-        if (!bullet.isAlive || bullet.type != BULLET || bullet.owner != 1) continue;
-
-        float distToPlayer = glm::length(bullet.location - cam_pos);
-        if (distToPlayer < bullet.collider_dimension / 2.0f) {
-            bullet.isAlive = false;
-
-            if (!gameOver && !gameWon) {
-                playerHealth -= 10;
-                playerHealth = std::max(0, playerHealth);  // clamp to 0
-                std::cout << "Hit by enemy bullet! Health: " << playerHealth << std::endl;
 
-                if (playerHealth <= 0) {
-                    gameOver = true;
-                    std::cout << "Game Over! You lost!" << std::endl;
-                }
-            }
+    pyramid.bind();
+    if (instancing) {
+        enemies.clear();
+        for (size_t i = 0; i < world.enemyList.size(); i++) {
+            if (!world.enemyList.isAlive[i] || world.enemyList.isCollided[i]) continue;
+            enemies.add(glm::mix(world.enemyList.previous_location[i], world.enemyList.location[i], renderAlpha), world.enemyList.scale[i], world.enemyList.textureID[i]);
         }
-
+        enemies.draw(pyramid.primitive(), 0, pyramid.vertexCount());
     }
-}
-
-
-void updateSceneGraph() {
-    checkCollisions();
-
-    for (int i = 0; i < sceneGraph.size(); i++) {
-        GameObject& go = sceneGraph[i];
-        if (go.life_span > 0 && go.isAlive && go.living_time >= go.life_span)
-            go.isAlive = false;
-        if (go.life_span > 0 && go.isAlive && go.living_time < go.life_span) {
-            go.location += ((GLfloat)deltaTime) * go.velocity * glm::normalize(go.moving_direction);
-            go.living_time += deltaTime;
-        }
-    }
-
-    for (int i = 0; i < enemyList.size(); i++) {
-        GameObject& enemy = enemyList[i];
-        if (!enemy.isAlive) continue;
-
-        // Move toward player
-        enemy.moving_direction = glm::normalize(cam_pos - enemy.location);
-        enemy.location += enemy.moving_direction * enemy.velocity * (GLfloat)deltaTime;
-
-        // === ENEMY SHOOTING ===
-        int now = glutGet(GLUT_ELAPSED_TIME);
-        if (now - enemy.lastShotTime > enemyShootCooldown) {
-            GameObject bullet;
-            bullet.owner = 1;  // Enemy
-            bullet.location = enemy.location;
-            bullet.rotation = glm::vec3(0);
-            bullet.scale = glm::vec3(0.07f);
-            bullet.collider_dimension = bullet.scale.x;
-            bullet.isAlive = true;
-            bullet.living_time = 0;
-            bullet.isCollided = false;
-            bullet.velocity = 0.006f;
-            bullet.type = BULLET;
-            bullet.moving_direction = glm::normalize(cam_pos - enemy.location);
-            bullet.life_span = 4000;
-            bullet.textureID = texture[1];
-            sceneGraph.push_back(bullet);
-
-            enemy.lastShotTime = now;
-        }
-
-        // Check collision with player
-        float dist = glm::length(cam_pos - enemy.location);
-        if (dist < enemy.collider_dimension / 2.0f) {
-            if (!gameOver && !gameWon && playerHealth > 0) {
-                playerHealth -= 10;
-                playerHealth = std::max(0, playerHealth);  // clamp to 0
-                enemy.isAlive = false;
-                std::cout << "Player hit! Health: " << playerHealth << std::endl;
-
-                if (playerHealth <= 0) {
-                    gameOver = true;
-                    std::cout << "Game Over! You lost!" << std::endl;
-                }
-            }
-        }
-
-    }
-}
-
-
-void draw_level() {
-    glBindTexture(GL_TEXTURE_2D, texture[0]);
-    glDrawArrays(GL_QUADS, 0, 4);
-    updateSceneGraph();
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-
-    for (GameObject& go : sceneGraph) {
-        if (go.isAlive && !go.isCollided) {
-            model_view = glm::translate(glm::mat4(1.0), go.location);
+    else {
+        for (size_t i = 0; i < world.enemyList.size(); i++) {
+            if (!world.enemyList.isAlive[i] || world.enemyList.isCollided[i]) continue;
+            model_view = glm::translate(glm::mat4(1.0), glm::mix(world.enemyList.previous_location[i], world.enemyList.location[i], renderAlpha));
+            model_view = glm::scale(model_view, world.enemyList.scale[i]);
             glUniformMatrix4fv(location, 1, GL_FALSE, &model_view[0][0]);
-            drawCube(go.scale, texture[1]);
+            glBindTexture(GL_TEXTURE_2D, world.enemyList.textureID[i]);
+            pyramid.draw();
             model_view = glm::mat4(1.0);
         }
     }
-    for (GameObject& enemy : enemyList) {
-        if (!enemy.isAlive || enemy.isCollided) continue;
-        model_view = glm::translate(glm::mat4(1.0), enemy.location);
-        glUniformMatrix4fv(location, 1, GL_FALSE, &model_view[0][0]);
-        //drawCube(enemy.scale, enemy.textureID);
-        drawPyramid(enemy.scale, enemy.textureID);
-        model_view = glm::mat4(1.0);
-    }
+    glBindVertexArray(0);
 }
 
 void renderBitmapString(float x, float y, void* font, const char* string) {
@@ -347,6 +166,7 @@ void drawTextBackgroundBox(float x, float y, float width, float height) {
 
 
 void display() {
+    frameStream.beginFrame();
     glEnable(GL_DEPTH_TEST);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -355,8 +175,8 @@ void display() {
     glUniformMatrix4fv(location, 1, GL_FALSE, &model_view[0][0]);
 
     // Camera matrix
-    glm::vec3 look_at = cam_pos + looking_dir_vector;
-    glm::mat4 camera_matrix = glm::lookAt(cam_pos, look_at, up_vector);
+    glm::vec3 look_at = world.cam_pos + world.looking_dir_vector;
+    glm::mat4 camera_matrix = glm::lookAt(world.cam_pos, look_at, world.up_vector);
     glUniformMatrix4fv(cam_mat_location, 1, GL_FALSE, &camera_matrix[0][0]);
 
     // Projection matrix
@@ -365,9 +185,10 @@ void display() {
 
     // Draw level and game objects
     draw_level();
+    frameStream.endFrame();
 
     // === Overlay: Win or Loss Message ===
-    if (gameWon || gameOver) {
+    if (world.gameWon || world.gameOver) {
         // Disable depth and texture so 2D overlay isn't affected
         glDisable(GL_TEXTURE_2D);
         glDisable(GL_DEPTH_TEST);
@@ -397,16 +218,16 @@ void display() {
 
         // Now draw the text on top of the background box
         glColor3f(1.0f, 1.0f, 1.0f);  // White
-        if (gameOver) {
+        if (world.gameOver) {
             renderBitmapString(420.0f, 520.0f, GLUT_BITMAP_HELVETICA_18, "Game Over! You lost!");
         }
-        else if (gameWon) {
+        else if (world.gameWon) {
             renderBitmapString(460.0f, 520.0f, GLUT_BITMAP_HELVETICA_18, "You Win!");
         }
 
         // Display Final Score
         char scoreText[64];
-        sprintf(scoreText, "Final Score: %d", playerScore);
+        sprintf(scoreText, "Final Score: %d", world.playerScore);
         renderBitmapString(440.0f, 500.0f, GLUT_BITMAP_HELVETICA_18, scoreText);
 
         // Restore projection and modelview matrices
@@ -427,123 +248,163 @@ void display() {
     glFlush();
 }
 
+const char* quickSavePath = "quicksave.snap";
+
 void keyboard(unsigned char key, int x, int y)
 {
-    if (gameWon || gameOver) return;  // freeze controls
-
-	if (key == 'a')
-	{
-		//Moving camera along opposit direction of side vector
-		cam_pos += side_vector * travel_speed * ((float)deltaTime) / 1000.0f;
-	}
-	if (key == 'd')
-	{
-		//Moving camera along side vector
-		cam_pos -= side_vector * travel_speed * ((float)deltaTime) / 1000.0f;
-	}
-	if (key == 'w')
-	{
-		//Moving camera along forward vector. To be more realistic, we use X=V.T equation in physics
-		cam_pos += forward_vector * travel_speed * ((float)deltaTime) / 1000.0f;
-	}
-	if (key == 's')
-	{
-		//Moving camera along backward (negative forward) vector. To be more realistic, we use X=V.T equation in physics
-		cam_pos -= forward_vector * travel_speed * ((float)deltaTime) / 1000.0f;
-	}
-
-	//Added on Nov. 21 2021 by: Alireza Moghaddam
-	if (key == 'f')
-	{
-		//Create a bullet
-
-        GameObject bullet;
-        bullet.owner = 0;  // Player
-        bullet.location = cam_pos;
-        bullet.rotation = glm::vec3(0);
-        bullet.scale = glm::vec3(0.07f);
-        bullet.collider_dimension = bullet.scale.x;
-        bullet.isAlive = true;
-        bullet.living_time = 0;
-        bullet.isCollided = false;
-        bullet.velocity = 0.01f;
-        bullet.type = BULLET;
-        bullet.moving_direction = looking_dir_vector;
-        bullet.life_span = 4000;
-        bullet.textureID = texture[1];
-        sceneGraph.push_back(bullet);
+    // k / l: quick save and quick load of the whole match
+    if (key == 'k') {
+        if (world.saveSnapshot(quickSavePath))
+            std::cout << "Saved " << quickSavePath << std::endl;
+        return;
+    }
+    if (key == 'i') {
+        instancing = !instancing;
+        std::cout << (instancing ? "Instanced drawing" : "One draw call per object") << std::endl;
+        return;
+    }
+    if (playingBack)
+        return; // the replay drives the world
+    if (key == 'l') {
+        if (!recordPath.empty()) {
+            std::cout << "Quick load is off while recording" << std::endl;
+            return;
+        }
+        if (world.loadSnapshot(quickSavePath))
+            std::cout << "Loaded " << quickSavePath << std::endl;
+        return;
     }
+    if (!recordPath.empty())
+        recording.addKey(world.simTime / simTickMs, key, deltaTime);
+    world.keyboard(key, deltaTime);
 }
 
-//Controlling Pitch with vertical mouse movement
 void mouse(int x, int y) {
-    int delta_x = x - x0;
-    forward_vector = glm::rotate(forward_vector, -delta_x * mouse_sensitivity, unit_z_vector);
-    looking_dir_vector = glm::rotate(looking_dir_vector, -delta_x * mouse_sensitivity, unit_z_vector);
-    side_vector = glm::rotate(side_vector, -delta_x * mouse_sensitivity, unit_z_vector);
-    up_vector = glm::rotate(up_vector, -delta_x * mouse_sensitivity, unit_z_vector);
-    x0 = x;
-
-    int delta_y = y - y_0;
-    glm::vec3 tmp_look = glm::rotate(looking_dir_vector, delta_y * mouse_sensitivity, side_vector);
-    if (glm::dot(tmp_look, forward_vector) > 0) {
-        looking_dir_vector = tmp_look;
-        up_vector = glm::rotate(up_vector, delta_y * mouse_sensitivity, side_vector);
-    }
-    y_0 = y;
+    if (playingBack)
+        return;
+    if (!recordPath.empty())
+        recording.addMouse(world.simTime / simTickMs, x, y);
+    world.mouse(x, y);
 }
 
-void idle() {
-    int timeSinceStart = glutGet(GLUT_ELAPSED_TIME);
-    deltaTime = timeSinceStart - oldTimeSinceStart;
-    oldTimeSinceStart = timeSinceStart;
+// Stamps the recording with its length and the final state, then writes it; runs when the window closes
+void saveRecording() {
+    recording.ticks = world.simTime / simTickMs;
+    recording.checksum = world.checksum();
+    if (recording.save(recordPath))
+        std::cout << "Recorded " << recording.ticks << " ticks and " << recording.inputs.size() << " inputs to " << recordPath << std::endl;
+}
 
-    if (!gameOver && !gameWon && timeSinceStart >= 30000) {
-        gameWon = true;
-        std::cout << "You Win!" << std::endl;
+// Replay with the renderer on: one tick per frame, as fast as frames come, then the report
+void playbackIdle() {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (playbackFrames > 0)
+        playbackMs += std::chrono::duration<double, std::milli>(now - lastFrameTime).count();
+    lastFrameTime = now;
+
+    int tick = world.simTime / simTickMs + 1;
+    if (tick > playback.ticks) {
+        playback.apply(world, tick, nextPlaybackInput); // inputs that came after the last tick
+        gameLog.flush();
+        reportReplay(playback, world, playbackMs, playbackFrames);
+        exit(world.checksum() == playback.checksum ? 0 : 1);
     }
+    playback.apply(world, tick, nextPlaybackInput);
+    world.simulateTick();
+    renderAlpha = 1.0f;
+    playbackFrames++;
+    glutPostRedisplay();
+}
 
-    if (!gameOver && !gameWon) {
-        spawnTimer += deltaTime;
-        if (spawnTimer >= spawnInterval) {
-            spawnTimer = 0;
-            spawnEnemy(enemyList, enemyTextureID);
-            spawnInterval = std::max(500.0f, spawnInterval - 50.0f);
+// === Draw benchmark ===
+// Renders the same static frame with one draw call per object and then instanced, timing each frame to glFinish()
+const int benchDrawWarmup = 20;
+const int benchDrawFrames = 200;
+int benchDrawFrame = 0;
+double benchDrawMs[2] = {};
+int benchDrawCalls[2] = {};
+size_t benchStaticBytes = 0;        // static mesh bytes uploaded before the first frame
+
+// A grid in front of the camera, which looks along +x +y from the origin: every other object is an enemy,
+// the rest are crate and fire cubes
+void setUpDrawBenchmark(int objects) {
+    benchStaticBytes = StaticMesh::bytesUploaded();
+    int side = (int)std::ceil(std::sqrt((double)objects));
+    for (int i = 0; i < objects; i++) {
+        glm::vec3 position(3.0f + (i % side) * 60.0f / side, 3.0f + (i / side) * 60.0f / side, 0.0f);
+        if (i % 2 == 1) {
+            GameObject enemy = world.makeEnemy(position);
+            enemy.scale = glm::vec3(0.3f);
+            world.addEnemy(enemy);
+            continue;
         }
+        GameObject cube = world.makeBullet(position, glm::vec3(0), 0.0f, 0);
+        cube.scale = glm::vec3(0.3f);
+        cube.textureID = i % 4 == 0 ? texture[1] : enemyTextureID;
+        world.addBullet(cube);
+    }
+}
+
+void drawBenchmarkIdle() {
+    int phase = benchDrawFrame / (benchDrawWarmup + benchDrawFrames);   // 0: per cube, 1: instanced
+    if (phase == 2) {
+        printf("draw benchmark, %d cubes and %d enemies in view:\n", (int)world.sceneGraph.size(), (int)world.enemyList.size());
+        printf("  one draw call per object  %.3f ms/frame, %d draw calls\n", benchDrawMs[0] / benchDrawFrames, benchDrawCalls[0]);
+        printf("  instanced                 %.3f ms/frame, %d draw calls (%.2fx)\n", benchDrawMs[1] / benchDrawFrames, benchDrawCalls[1],
+            benchDrawMs[0] / std::max(benchDrawMs[1], 1e-9));
+        printf("  static meshes: %d bytes uploaded at startup, %d bytes while drawing\n",
+            (int)benchStaticBytes, (int)(StaticMesh::bytesUploaded() - benchStaticBytes));
+        printf("  instance data: %s, %d frames fell back to glBufferData, %d waits for the GPU (%.3f ms)\n",
+            frameStream.ready() ? "persistent mapped ring" : "orphaned buffers", (int)(cubes.orphanedFrames + enemies.orphanedFrames),
+            (int)frameStream.waits, frameStream.waitMs);
+        exit(0);
+    }
+    instancing = phase == 1;
+    renderAlpha = 1.0f;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    display();
+    glFinish();
+    if (benchDrawFrame % (benchDrawWarmup + benchDrawFrames) >= benchDrawWarmup)
+        benchDrawMs[phase] += elapsedMs(start);
+    benchDrawCalls[phase] = instancing ? cubes.drawCalls() + enemies.drawCalls() : (int)(world.sceneGraph.size() + world.enemyList.size());
+    benchDrawFrame++;
+}
+
+void idle() {
+    if (benchDrawObjects > 0) {
+        drawBenchmarkIdle();
+        return;
     }
+    if (playingBack) {
+        playbackIdle();
+        return;
+    }
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    deltaTime = std::chrono::duration<float, std::milli>(now - lastFrameTime).count();
+    lastFrameTime = now;
+
+    // Run as many fixed ticks as the elapsed real time covers; rendering interpolates the remainder
+    simAccumulator += deltaTime;
+    int ticks = 0;
+    while (simAccumulator >= simTickMs && ticks < maxTicksPerFrame) {
+        world.simulateTick();
+        simAccumulator -= simTickMs;
+        ticks++;
+    }
+    if (ticks == maxTicksPerFrame)
+        simAccumulator = std::min(simAccumulator, (double)simTickMs); // drop the backlog instead of spiralling
+    renderAlpha = (float)(simAccumulator / simTickMs);
 
     glutPostRedisplay();
 }
 
 void init()
 {
-    //Normalizing all vectors
-    up_vector = glm::normalize(up_vector);
-    forward_vector = glm::normalize(forward_vector);
-    looking_dir_vector = glm::normalize(looking_dir_vector);
-    side_vector = glm::normalize(side_vector);
-
-    //Randomizing obstacles and adding them to the GameScene
-    for (int i = 0; i < Num_Obstacles; i++)
-    {
-        obstacle_data[i][0] = randomFloat(-50, 50); //X
-        obstacle_data[i][1] = randomFloat(-50, 50); //Y
-        obstacle_data[i][2] = randomFloat(0.1f, 10.0f); //Scale
-
-        GameObject go;
-        go.location = glm::vec3(obstacle_data[i][0], obstacle_data[i][1], 0);
-        go.rotation = glm::vec3(0, 0, 0);
-        go.scale = glm::vec3(obstacle_data[i][2], obstacle_data[i][2], obstacle_data[i][2]);
-        go.collider_dimension = go.scale.x;
-        go.isAlive = true;
-        go.living_time = 0;
-        go.isCollided = false;
-        go.velocity = 0;
-        go.type = OBSTACLE;
-        go.moving_direction = glm::vec3(0, 0, 0);
-        go.life_span = -1;
-        sceneGraph.push_back(go);
-    }
+    world.jobs = &jobs;
+    world.eventLog = &gameLog;
+    world.initScene();
 
     enemyTextureID = SOIL_load_OGL_texture("fire.png", SOIL_LOAD_AUTO, SOIL_CREATE_NEW_ID, SOIL_FLAG_MIPMAPS | SOIL_FLAG_INVERT_Y);
     if (enemyTextureID == 0) {
@@ -552,6 +413,7 @@ void init()
     else {
         std::cout << "Enemy texture loaded: " << enemyTextureID << std::endl;
     }
+    world.enemyTexture = enemyTextureID;
     glBindTexture(GL_TEXTURE_2D, enemyTextureID);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -606,11 +468,28 @@ void init()
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, BUFFER_OFFSET(0));
     glEnableVertexAttribArray(1);
 
+    if (!frameStream.init(frameStreamBytes))
+        printf("no buffer storage, instance data goes through glBufferData\n");
+    cubes.init(program, &frameStream, &objectTextures);
+    enemies.init(program, &frameStream, &objectTextures);
+
+    // Apex up along +y over a square base, bottom face split into two triangles
+    MeshVertex pyramidVertices[18] = {
+        { { 0.0f, 1.0f, 0.0f }, { 0.5f, 1.0f } }, { { -0.5f, 0.0f, 0.5f }, { 0.0f, 0.0f } }, { { 0.5f, 0.0f, 0.5f }, { 1.0f, 0.0f } },     // front
+        { { 0.0f, 1.0f, 0.0f }, { 0.5f, 1.0f } }, { { 0.5f, 0.0f, 0.5f }, { 0.0f, 0.0f } }, { { 0.5f, 0.0f, -0.5f }, { 1.0f, 0.0f } },     // right
+        { { 0.0f, 1.0f, 0.0f }, { 0.5f, 1.0f } }, { { 0.5f, 0.0f, -0.5f }, { 0.0f, 0.0f } }, { { -0.5f, 0.0f, -0.5f }, { 1.0f, 0.0f } },   // back
+        { { 0.0f, 1.0f, 0.0f }, { 0.5f, 1.0f } }, { { -0.5f, 0.0f, -0.5f }, { 0.0f, 0.0f } }, { { -0.5f, 0.0f, 0.5f }, { 1.0f, 0.0f } },   // left
+        { { -0.5f, 0.0f, 0.5f }, { 0.0f, 0.0f } }, { { 0.5f, 0.0f, 0.5f }, { 1.0f, 0.0f } }, { { 0.5f, 0.0f, -0.5f }, { 1.0f, 1.0f } },    // bottom
+        { { -0.5f, 0.0f, 0.5f }, { 0.0f, 0.0f } }, { { 0.5f, 0.0f, -0.5f }, { 1.0f, 1.0f } }, { { -0.5f, 0.0f, -0.5f }, { 0.0f, 1.0f } },
+    };
+    pyramid.upload(GL_TRIANGLES, pyramidVertices, 18);
+
     location = glGetUniformLocation(program, "model_matrix");
     cam_mat_location = glGetUniformLocation(program, "camera_matrix");
     proj_mat_location = glGetUniformLocation(program, "projection_matrix");
 
     glGenTextures(2, texture);
+    world.bulletTexture = texture[1];
 
     glBindTexture(GL_TEXTURE_2D, texture[0]);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width1, height1, 0, GL_RGB, GL_UNSIGNED_BYTE, textureData1);
@@ -625,6 +504,19 @@ void init()
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+
+    // The same images again as layers of one array texture for the instanced draws; fire.png was
+    // loaded flipped by SOIL above, so it is flipped here too
+    if (textureData2 != NULL)
+        objectTextures.add(texture[1], textureData2, width2, height2, 3);
+    GLint fireWidth, fireHeight;
+    unsigned char* fireData = SOIL_load_image("fire.png", &fireWidth, &fireHeight, 0, SOIL_LOAD_RGBA);
+    if (fireData != NULL && enemyTextureID != 0)
+        objectTextures.add(enemyTextureID, fireData, fireWidth, fireHeight, 4, true);
+    SOIL_free_image_data(fireData);
+    if (objectTextures.build(program))
+        printf("texture array: %d textures in %d layers of %dx%d\n", objectTextures.entryCount(), objectTextures.layerCount(),
+            objectTextures.layerSize(), objectTextures.layerSize());
     
     // Set a bright sky blue background
     glClearColor(0.4f, 0.7f, 1.0f, 1.0f);  // R, G, B, A
@@ -632,7 +524,271 @@ void init()
 }
 
 
+// === Headless mode ===
+// Runs the simulation without a window or GL context and reports what each phase costs per tick
+void printSimStats(const char* label, const World& w, const SimStats& stats, int ticks) {
+    printf("%s %6d enemies %7d scene objects | per tick: spawn %.3f ms, movement %.3f ms, shooting %.3f ms, collision %.3f ms, reclaim %.3f ms\n",
+        label, (int)w.enemyList.size(), (int)w.sceneGraph.size(),
+        stats.spawnMs / ticks, stats.movementMs / ticks, stats.shootingMs / ticks, stats.collisionMs / ticks, stats.reclaimMs / ticks);
+}
+
+// Entity counts against the slots and memory the stores hold on to; flat slots and capacity over a long run mean nothing leaks
+void printStoreSizes(const char* label, const World& w) {
+    printf("%s scene objects %7d live %7d slots %7d capacity | enemies %7d live %7d slots %7d capacity\n", label,
+        (int)w.sceneGraph.size(), (int)w.sceneGraph.slotCount(), (int)w.sceneGraph.location.capacity(),
+        (int)w.enemyList.size(), (int)w.enemyList.slotCount(), (int)w.enemyList.location.capacity());
+}
+
+// Applies a scenario's settings and preload to a fresh world
+void setUpWorld(World& w, const Scenario& scenario, unsigned int seed) {
+    w.rng.seed(seed);
+    if (!scenario.lodBands.empty()) {
+        w.updateBands.clear();
+        for (const ScenarioBand& band : scenario.lodBands)
+            w.updateBands.push_back(UpdateBand{ band.minDistance, band.interval });
+    }
+    w.numObstacles = scenario.obstacles;
+    w.obstacleArea = scenario.obstacleArea;
+    w.spawnInterval = scenario.spawnInterval;
+    w.winTime = scenario.winTime;
+    w.initScene();
+    w.playerHealth = scenario.health;
+
+    // Preload the population over the arena; spread the fire cooldowns so the first volley is not one giant tick
+    for (int i = 0; i < scenario.enemies; i++) {
+        glm::vec3 position(w.rng.uniform(-scenario.arena, scenario.arena), 0.5f, w.rng.uniform(-scenario.arena, scenario.arena));
+        GameObject enemy = w.makeEnemy(position);
+        enemy.lastShotTime = -(int)(w.rng.next() % enemyShootCooldown);
+        w.addEnemy(enemy);
+    }
+    for (int i = 0; i < scenario.bullets; i++) {
+        glm::vec3 position(w.rng.uniform(-scenario.arena, scenario.arena), w.rng.uniform(-scenario.arena, scenario.arena), w.rng.uniform(0.1f, 2.0f));
+        glm::vec3 direction(w.rng.uniform(-1, 1), w.rng.uniform(-1, 1), 0.01f);
+        w.addBullet(w.makeBullet(position, direction, 0.01f, 0));
+    }
+}
+
+// Feeds the world the scripted inputs due at this tick; nextInput carries over between ticks
+void applyScriptedInputs(World& w, const Scenario& scenario, int tick, size_t& nextInput) {
+    const float inputFrameMs = (float)simTickMs; // scripted movement keys advance one tick's worth
+    while (nextInput < scenario.inputs.size() && scenario.inputs[nextInput].tick <= tick) {
+        const ScriptedInput& input = scenario.inputs[nextInput++];
+        if (input.isMouse)
+            w.mouse(input.x, input.y);
+        else
+            w.keyboard(input.key, inputFrameMs);
+    }
+}
+
+int runHeadless(const Scenario& scenario) {
+    if (scenario.lodBands.size() > (size_t)maxUpdateBands) {
+        printf("at most %d lod bands are supported\n", maxUpdateBands);
+        return 1;
+    }
+    gameLog.setRateLimit(LOG_BULLET_HIT_ENEMY, scenario.logLimit);
+    gameLog.setRateLimit(LOG_ENEMY_BULLET_HIT_PLAYER, scenario.logLimit);
+    gameLog.setRateLimit(LOG_ENEMY_HIT_PLAYER, scenario.logLimit);
+    gameLog.start();
+    jobs.start(scenario.threads);
+
+    World& w = world;
+    w.jobs = &jobs;
+    w.eventLog = &gameLog;
+
+    // A loaded snapshot picks up on the tick after the one it was saved on
+    int firstTick = 1;
+    size_t nextInput = 0;
+    if (!scenario.loadSnapshotPath.empty()) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (!w.loadSnapshot(scenario.loadSnapshotPath.c_str())) {
+            gameLog.stop();
+            return 1;
+        }
+        printf("restored %s in %.3f ms: %d enemies, %d scene objects, simulated %d ms\n", scenario.loadSnapshotPath.c_str(),
+            elapsedMs(start), (int)w.enemyList.size(), (int)w.sceneGraph.size(), w.simTime);
+        firstTick = w.simTime / simTickMs + 1;
+        while (nextInput < scenario.inputs.size() && scenario.inputs[nextInput].tick < firstTick)
+            nextInput++;
+    }
+    else
+        setUpWorld(w, scenario, scenario.seed);
+
+    SimStats window;
+    for (int tick = firstTick; tick <= scenario.ticks; tick++) {
+        applyScriptedInputs(w, scenario, tick, nextInput);
+
+        SimStats before = w.simStats;
+        w.simulateTick();
+        window.spawnMs += w.simStats.spawnMs - before.spawnMs;
+        window.movementMs += w.simStats.movementMs - before.movementMs;
+        window.shootingMs += w.simStats.shootingMs - before.shootingMs;
+        window.collisionMs += w.simStats.collisionMs - before.collisionMs;
+        window.reclaimMs += w.simStats.reclaimMs - before.reclaimMs;
+
+        if (scenario.reportEvery > 0 && tick % scenario.reportEvery == 0) {
+            gameLog.flush(); // keep the report after the hits of the same ticks
+            char label[32];
+            sprintf(label, "tick %6d:", tick);
+            printSimStats(label, w, window, scenario.reportEvery);
+            window = SimStats();
+        }
+        if (scenario.sizeReportEvery > 0 && tick % scenario.sizeReportEvery == 0) {
+            gameLog.flush();
+            char label[32];
+            sprintf(label, "tick %6d:", tick);
+            printStoreSizes(label, w);
+        }
+
+        if (tick == scenario.saveSnapshotTick && !scenario.saveSnapshotPath.empty()) {
+            gameLog.flush();
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            if (w.saveSnapshot(scenario.saveSnapshotPath.c_str()))
+                printf("saved %s after tick %d in %.3f ms\n", scenario.saveSnapshotPath.c_str(), tick, elapsedMs(start));
+        }
+    }
+
+    gameLog.stop();
+    printSimStats("average:   ", w, w.simStats, std::max(1, scenario.ticks - firstTick + 1));
+    for (size_t b = 0; b < w.updateBands.size(); b++) {
+        printf("lod band from %6.1f: every %d ticks, %lld updates, %lld skipped\n",
+            w.updateBands[b].minDistance, w.updateBands[b].interval, w.lodStats.updated[b], w.lodStats.skipped[b]);
+    }
+    printf("score %d, health %d, simulated %d ms, %u worker threads\n", w.playerScore, w.playerHealth, w.simTime, jobs.workerCount());
+    return 0;
+}
+
+
+// === Replay mode ===
+// Prints how long a replay took and whether it ended where the recording did
+void reportReplay(const Replay& replay, const World& w, double totalMs, int frames) {
+    printSimStats("average:   ", w, w.simStats, std::max(1, replay.ticks));
+    printf("replayed %d ticks, %d inputs in %.1f ms: %.3f ms per tick", replay.ticks, (int)replay.inputs.size(), totalMs, totalMs / std::max(1, replay.ticks));
+    if (frames > 0)
+        printf(", %d frames at %.3f ms per frame", frames, totalMs / frames);
+    printf("\n");
+    uint64_t checksum = w.checksum();
+    printf("score %d, health %d, checksum %016llx %s\n", w.playerScore, w.playerHealth, (unsigned long long)checksum,
+        checksum == replay.checksum ? "matches the recording" : "DIFFERS from the recording");
+}
+
+// Replay with the renderer off, as fast as the simulation goes
+int runReplay(const Replay& replay) {
+    jobs.start(0);
+    World& w = world;
+    w.jobs = &jobs;
+    w.rng.seed(replay.seed);
+    w.initScene();
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    size_t next = 0;
+    for (int tick = 1; tick <= replay.ticks; tick++) {
+        replay.apply(w, tick, next);
+        w.simulateTick();
+    }
+    replay.apply(w, replay.ticks + 1, next); // inputs that came after the last tick
+    reportReplay(replay, w, elapsedMs(start), 0);
+    return w.checksum() == replay.checksum ? 0 : 1;
+}
+
+
+// === Batch mode ===
+// Plays the scenario in many independent worlds at once, one world per job, each seeded seed + k.
+// Worlds share nothing, so the thread pool only ever hands out whole worlds
+int runBatch(const Scenario& scenario, int worldCount) {
+    if (scenario.lodBands.size() > (size_t)maxUpdateBands) {
+        printf("at most %d lod bands are supported\n", maxUpdateBands);
+        return 1;
+    }
+    worldCount = std::max(1, worldCount);
+    jobs.start(scenario.threads);
+
+    std::vector<std::unique_ptr<World>> worlds(worldCount);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    jobs.parallelFor(worlds.size(), 1, [&](size_t begin, size_t end, unsigned) {
+        for (size_t k = begin; k < end; k++) {
+            worlds[k].reset(new World());
+            World& w = *worlds[k];
+            setUpWorld(w, scenario, scenario.seed + (unsigned int)k);
+
+            size_t nextInput = 0;
+            for (int tick = 1; tick <= scenario.ticks; tick++) {
+                applyScriptedInputs(w, scenario, tick, nextInput);
+                w.simulateTick();
+            }
+        }
+    });
+    double seconds = elapsedMs(start) / 1000.0;
+
+    int won = 0, lost = 0;
+    long long totalScore = 0;
+    for (size_t k = 0; k < worlds.size(); k++) {
+        const World& w = *worlds[k];
+        const char* result = w.gameOver ? "lost" : w.gameWon ? "won" : "undecided";
+        printf("world %4d seed %u: score %d, health %d, %s, %d enemies left\n",
+            (int)k, scenario.seed + (unsigned int)k, w.playerScore, w.playerHealth, result, (int)w.enemyList.size());
+        won += w.gameWon ? 1 : 0;
+        lost += w.gameOver ? 1 : 0;
+        totalScore += w.playerScore;
+    }
+
+    double worldTicks = (double)worldCount * scenario.ticks;
+    printf("%d worlds: %d won, %d lost, %d undecided, mean score %.1f\n",
+        worldCount, won, lost, worldCount - won - lost, (double)totalScore / worldCount);
+    printf("%.0f world-ticks in %.3f s on %u worker threads: %.0f world-ticks/s, %.0f world-ticks/s per core\n",
+        worldTicks, seconds, jobs.workerCount(), worldTicks / seconds, worldTicks / seconds / jobs.workerCount());
+    return 0;
+}
+
+
 int main(int argc, char** argv) {
+    // 3D_World --headless <scenario file>
+    if (argc >= 3 && std::string(argv[1]) == "--headless") {
+        Scenario scenario;
+        if (!scenario.load(argv[2]))
+            return 1;
+        return runHeadless(scenario);
+    }
+    // 3D_World --batch <scenario file> <worlds>
+    if (argc >= 4 && std::string(argv[1]) == "--batch") {
+        Scenario scenario;
+        if (!scenario.load(argv[2]))
+            return 1;
+        return runBatch(scenario, atoi(argv[3]));
+    }
+    // 3D_World --replay <replay file> [--render]
+    if (argc >= 3 && std::string(argv[1]) == "--replay") {
+        if (!playback.load(argv[2]))
+            return 1;
+        if (argc < 4 || std::string(argv[3]) != "--render")
+            return runReplay(playback);
+        playingBack = true;
+        world.rng.seed(playback.seed);
+    }
+    // 3D_World --record <replay file> [seed]
+    if (argc >= 3 && std::string(argv[1]) == "--record") {
+        recordPath = argv[2];
+        recording.seed = argc >= 4 ? strtoull(argv[3], nullptr, 10) : 1;
+        world.rng.seed(recording.seed);
+    }
+    // 3D_World --bench-draw [objects]
+    if (argc >= 2 && std::string(argv[1]) == "--bench-draw")
+        benchDrawObjects = argc >= 3 ? std::max(1, atoi(argv[2])) : 10000;
+    // 3D_World --bench-aabb
+    if (argc >= 2 && std::string(argv[1]) == "--bench-aabb")
+        return runAabbBenchmark();
+    // 3D_World --bench-soa [entities]
+    if (argc >= 2 && std::string(argv[1]) == "--bench-soa")
+        return runSoaBenchmark(argc >= 3 ? atoi(argv[2]) : 1000000);
+    // 3D_World --bench-dispatch [tanks]
+    if (argc >= 2 && std::string(argv[1]) == "--bench-dispatch")
+        return runDispatchBenchmark(argc >= 3 ? atoi(argv[2]) : 1000);
+    // 3D_World --bench-ecs [entities]
+    if (argc >= 2 && std::string(argv[1]) == "--bench-ecs")
+        return runEcsBenchmark(argc >= 3 ? atoi(argv[2]) : 100000);
+    // 3D_World --bench-transforms [tanks]
+    if (argc >= 2 && std::string(argv[1]) == "--bench-transforms")
+        return runTransformBenchmark(argc >= 3 ? atoi(argv[2]) : 10000);
+
     glutInit(&argc, argv);
     glutInitDisplayMode(GLUT_RGBA | GLUT_DEPTH);
     glutInitWindowSize(1024, 1024);
@@ -640,11 +796,23 @@ int main(int argc, char** argv) {
 
     glewInit();
     init();
+    if (benchDrawObjects > 0)
+        setUpDrawBenchmark(benchDrawObjects);
+    jobs.start(0);
+
+    // Hit messages come in bursts when many bullets land at once; a few a second are enough to follow the game
+    gameLog.setRateLimit(LOG_BULLET_HIT_ENEMY, 10);
+    gameLog.setRateLimit(LOG_ENEMY_BULLET_HIT_PLAYER, 10);
+    gameLog.setRateLimit(LOG_ENEMY_HIT_PLAYER, 10);
+    gameLog.start();
 
     glutDisplayFunc(display);
     glutKeyboardFunc(keyboard);
     glutIdleFunc(idle);
     glutPassiveMotionFunc(mouse);
+    if (!recordPath.empty())
+        atexit(saveRecording);
+    lastFrameTime = std::chrono::steady_clock::now();
     glutMainLoop();
     return 0;
 }
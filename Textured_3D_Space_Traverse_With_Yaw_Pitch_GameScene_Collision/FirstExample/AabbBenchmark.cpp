@@ -0,0 +1,64 @@
+#include "Benchmarks.h"
+#include "World.h"
+#include <cstdio>
+#include <algorithm>
+
+// Times the bullet-vs-enemy narrowphase: aabbOverlap() per pair against every kernel level this CPU runs
+int runAabbBenchmark() {
+    const int bullets = 4096;
+    const int batchSizes[] = { 8, 32, 256 };
+    WorldRandom rng;
+    rng.seed(1);
+
+    std::vector<glm::vec3> bulletCenters(bullets);
+    for (glm::vec3& c : bulletCenters)
+        c = glm::vec3(rng.uniform(-4, 4), rng.uniform(-4, 4), rng.uniform(0, 2));
+
+    printf("narrowphase kernels, best available: %s\n", aabbKernelName(aabbKernelSupported()));
+    for (int batch : batchSizes) {
+        std::vector<glm::vec3> centers(batch);
+        std::vector<GLfloat> sizes(batch);
+        AabbBoxes boxes;
+        for (int k = 0; k < batch; k++) {
+            centers[k] = glm::vec3(rng.uniform(-4, 4), rng.uniform(-4, 4), 0.5f);
+            sizes[k] = rng.uniform(0.5f, 1.5f);
+            boxes.push(centers[k], sizes[k]);
+        }
+        int repeats = std::max(1, (1 << 24) / (bullets * batch));
+        double tests = (double)repeats * bullets * batch;
+
+        // Reference: the scalar test the narrowphase used per pair
+        std::vector<uint8_t> expected((size_t)bullets * batch);
+        int hits = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; r++) {
+            for (int b = 0; b < bullets; b++)
+                for (int k = 0; k < batch; k++)
+                    expected[(size_t)b * batch + k] = aabbOverlap(bulletCenters[b], 0.07f, centers[k], sizes[k]);
+        }
+        float referenceMs = elapsedMs(start);
+        for (uint8_t e : expected)
+            hits += e;
+        printf("  %3d boxes per bullet, %7d hits | aabbOverlap %.3f ns per test", batch, hits, referenceMs * 1e6 / tests);
+
+        std::vector<uint32_t> masks;
+        for (int level = AABB_SCALAR; level <= aabbKernelSupported(); level++) {
+            setAabbKernelLevel(level);
+            bool same = true;
+            start = std::chrono::steady_clock::now();
+            for (int r = 0; r < repeats; r++) {
+                for (int b = 0; b < bullets; b++) {
+                    aabbOverlapMasks(bulletCenters[b], 0.07f, boxes, masks);
+                    if (r == 0) {
+                        for (int k = 0; k < batch; k++)
+                            same = same && (((masks[k / 32] >> (k % 32)) & 1) == expected[(size_t)b * batch + k]);
+                    }
+                }
+            }
+            printf(", %s %.3f ns%s", aabbKernelName(level), elapsedMs(start) * 1e6 / tests, same ? "" : " (MISMATCH)");
+        }
+        printf("\n");
+    }
+    setAabbKernelLevel(aabbKernelSupported());
+    return 0;
+}
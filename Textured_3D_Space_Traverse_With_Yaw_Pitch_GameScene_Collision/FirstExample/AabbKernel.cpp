@@ -0,0 +1,147 @@
+#include "AabbKernel.h"
+#include <cmath>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define AABB_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define AABB_TARGET_SSE
+#define AABB_TARGET_AVX2
+#else
+#define AABB_TARGET_SSE __attribute__((target("sse2")))
+#define AABB_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+typedef void (*AabbKernelFn)(glm::vec3 center, float half, const AabbBoxes& boxes, size_t begin, uint32_t* masks);
+
+//boxes from begin to the end, one at a time
+static void overlapScalar(glm::vec3 center, float half, const AabbBoxes& boxes, size_t begin, uint32_t* masks)
+{
+	for (size_t k = begin; k < boxes.size(); k++) {
+		float reach = half + boxes.half[k];
+		if (std::fabs(center.x - boxes.x[k]) <= reach &&
+			std::fabs(center.y - boxes.y[k]) <= reach &&
+			std::fabs(center.z - boxes.z[k]) <= reach)
+			masks[k / 32] |= 1u << (k % 32);
+	}
+}
+
+#ifdef AABB_X86
+AABB_TARGET_SSE
+static void overlapSSE(glm::vec3 center, float half, const AabbBoxes& boxes, size_t begin, uint32_t* masks)
+{
+	const __m128 signBits = _mm_set1_ps(-0.0f);
+	const __m128 cx = _mm_set1_ps(center.x), cy = _mm_set1_ps(center.y), cz = _mm_set1_ps(center.z);
+	const __m128 ch = _mm_set1_ps(half);
+
+	size_t k = begin;
+	for (; k + 4 <= boxes.size(); k += 4) {
+		__m128 reach = _mm_add_ps(ch, _mm_loadu_ps(&boxes.half[k]));
+		__m128 dx = _mm_andnot_ps(signBits, _mm_sub_ps(cx, _mm_loadu_ps(&boxes.x[k])));
+		__m128 dy = _mm_andnot_ps(signBits, _mm_sub_ps(cy, _mm_loadu_ps(&boxes.y[k])));
+		__m128 dz = _mm_andnot_ps(signBits, _mm_sub_ps(cz, _mm_loadu_ps(&boxes.z[k])));
+		__m128 hit = _mm_and_ps(_mm_and_ps(_mm_cmple_ps(dx, reach), _mm_cmple_ps(dy, reach)), _mm_cmple_ps(dz, reach));
+		masks[k / 32] |= (uint32_t)_mm_movemask_ps(hit) << (k % 32);
+	}
+	overlapScalar(center, half, boxes, k, masks);
+}
+
+AABB_TARGET_AVX2
+static void overlapAVX2(glm::vec3 center, float half, const AabbBoxes& boxes, size_t begin, uint32_t* masks)
+{
+	const __m256 signBits = _mm256_set1_ps(-0.0f);
+	const __m256 cx = _mm256_set1_ps(center.x), cy = _mm256_set1_ps(center.y), cz = _mm256_set1_ps(center.z);
+	const __m256 ch = _mm256_set1_ps(half);
+
+	size_t k = begin;
+	for (; k + 8 <= boxes.size(); k += 8) {
+		__m256 reach = _mm256_add_ps(ch, _mm256_loadu_ps(&boxes.half[k]));
+		__m256 dx = _mm256_andnot_ps(signBits, _mm256_sub_ps(cx, _mm256_loadu_ps(&boxes.x[k])));
+		__m256 dy = _mm256_andnot_ps(signBits, _mm256_sub_ps(cy, _mm256_loadu_ps(&boxes.y[k])));
+		__m256 dz = _mm256_andnot_ps(signBits, _mm256_sub_ps(cz, _mm256_loadu_ps(&boxes.z[k])));
+		__m256 hit = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(dx, reach, _CMP_LE_OQ), _mm256_cmp_ps(dy, reach, _CMP_LE_OQ)), _mm256_cmp_ps(dz, reach, _CMP_LE_OQ));
+		masks[k / 32] |= (uint32_t)_mm256_movemask_ps(hit) << (k % 32);
+	}
+	//avoid the AVX to SSE transition penalty before the tail
+	_mm256_zeroupper();
+	overlapScalar(center, half, boxes, k, masks);
+}
+#endif
+
+static int detectLevel()
+{
+#ifdef AABB_X86
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	int maxLeaf = info[0];
+	__cpuid(info, 1);
+	bool sse2 = (info[3] & (1 << 26)) != 0;
+	bool osSavesAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 6) == 6);
+	bool avx2 = false;
+	if (osSavesAvx && maxLeaf >= 7) {
+		__cpuidex(info, 7, 0);
+		avx2 = (info[1] & (1 << 5)) != 0;
+	}
+#else
+	__builtin_cpu_init();
+	bool sse2 = __builtin_cpu_supports("sse2");
+	bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+	if (avx2) return AABB_AVX2;
+	if (sse2) return AABB_SSE;
+#endif
+	return AABB_SCALAR;
+}
+
+static AabbKernelFn kernelFor(int level)
+{
+#ifdef AABB_X86
+	if (level == AABB_AVX2) return overlapAVX2;
+	if (level == AABB_SSE) return overlapSSE;
+#endif
+	return overlapScalar;
+}
+
+//picked while the program loads, before any thread can call the kernel
+static const int supportedLevel = detectLevel();
+static int activeLevel = supportedLevel;
+static AabbKernelFn activeKernel = kernelFor(supportedLevel);
+
+int aabbKernelSupported()
+{
+	return supportedLevel;
+}
+
+int aabbKernelLevel()
+{
+	return activeLevel;
+}
+
+void setAabbKernelLevel(int level)
+{
+	if (level > supportedLevel)
+		level = supportedLevel;
+	if (level < AABB_SCALAR)
+		level = AABB_SCALAR;
+	activeLevel = level;
+	activeKernel = kernelFor(level);
+}
+
+const char* aabbKernelName(int level)
+{
+	switch (level) {
+	case AABB_AVX2: return "AVX2";
+	case AABB_SSE: return "SSE";
+	default: return "scalar";
+	}
+}
+
+void aabbOverlapMasks(glm::vec3 center, float size, const AabbBoxes& boxes, std::vector<uint32_t>& masks)
+{
+	masks.assign((boxes.size() + 31) / 32, 0);
+	if (boxes.size() > 0)
+		activeKernel(center, size / 2, boxes, 0, &masks[0]);
+}
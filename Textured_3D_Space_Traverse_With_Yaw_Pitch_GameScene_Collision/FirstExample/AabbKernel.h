@@ -0,0 +1,50 @@
+#pragma once
+#include "glm\glm.hpp"
+#include <vector>
+#include <cstdint>
+
+/*************************************************
+
+	Batched AABB overlap narrowphase
+
+	Tests one cube against many packed cubes and
+	sets a bit per overlap. The AVX2 path tests 8
+	boxes per step, the SSE path 4, and the scalar
+	path one; all three evaluate the same float
+	expression as aabbOverlap(), so the hits are
+	identical whichever one runs.
+
+	The widest path the CPU supports is picked when
+	the program starts.
+
+**************************************************/
+
+enum AabbKernel_Level {
+	AABB_SCALAR,
+	AABB_SSE,
+	AABB_AVX2
+};
+
+//boxes stored one array per coordinate so a kernel step loads neighbouring boxes with one instruction each
+struct AabbBoxes
+{
+	std::vector<float> x, y, z;
+	std::vector<float> half;	//half the collider size
+
+	void clear() { x.clear(); y.clear(); z.clear(); half.clear(); }
+	void push(glm::vec3 center, float size) { x.push_back(center.x); y.push_back(center.y); z.push_back(center.z); half.push_back(size / 2); }
+	size_t size() const { return x.size(); }
+};
+
+//bit k % 32 of masks[k / 32] is set when boxes[k] overlaps the cube; masks is resized to fit
+void aabbOverlapMasks(glm::vec3 center, float size, const AabbBoxes& boxes, std::vector<uint32_t>& masks);
+
+//the best level this CPU can run
+int aabbKernelSupported();
+
+//the level aabbOverlapMasks() uses; can be lowered for comparisons, never raised past what is supported.
+//Only change it while no other thread is running the kernel
+int aabbKernelLevel();
+void setAabbKernelLevel(int level);
+
+const char* aabbKernelName(int level);
@@ -0,0 +1,104 @@
+#include "ArchetypeStore.h"
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <utility>
+
+//fixed array so a type registering on one thread never moves sizes another thread is reading
+static size_t componentSizes[maxComponentTypes];
+static std::atomic<int> componentTypes(0);
+
+int registerComponentType(size_t size)
+{
+	int id = componentTypes++;
+	if (id >= maxComponentTypes) {
+		//a ComponentMask has one bit per type; another type would alias an existing bit in every build
+		fprintf(stderr, "ArchetypeStore: more than %d component types\n", maxComponentTypes);
+		std::abort();
+	}
+	componentSizes[id] = size;
+	return id;
+}
+
+int ArchetypeStore::archetypeFor(ComponentMask mask)
+{
+	for (size_t a = 0; a < archetypes.size(); a++) {
+		if (archetypes[a].mask == mask)
+			return (int)a;
+	}
+	Archetype archetype;
+	archetype.mask = mask;
+	archetype.open = 0;
+	archetypes.push_back(archetype);
+	return (int)archetypes.size() - 1;
+}
+
+void* ArchetypeStore::component(const Location& at, int id)
+{
+	Archetype& archetype = archetypes[at.archetype];
+	if (!(archetype.mask & (1u << id)))
+		return nullptr;
+	return &archetype.chunks[at.chunk].columns[id][at.row * componentSizes[id]];
+}
+
+EcsEntity ArchetypeStore::create(ComponentMask mask)
+{
+	Location at;
+	at.archetype = archetypeFor(mask);
+	Archetype& archetype = archetypes[at.archetype];
+
+	while (archetype.open < archetype.chunks.size() && archetype.chunks[archetype.open].count == chunkCapacity)
+		archetype.open++;
+	if (archetype.open == archetype.chunks.size()) {
+		Chunk chunk;
+		chunk.count = 0;
+		chunk.entities.resize(chunkCapacity);
+		for (int id = 0; id < maxComponentTypes; id++) {
+			if (mask & (1u << id))
+				chunk.columns[id].resize(chunkCapacity * componentSizes[id]);
+		}
+		archetype.chunks.push_back(std::move(chunk));
+	}
+
+	Chunk& chunk = archetype.chunks[archetype.open];
+	at.chunk = (int)archetype.open;
+	at.row = (int)chunk.count++;
+	for (int id = 0; id < maxComponentTypes; id++) {
+		if (mask & (1u << id))
+			std::memset(&chunk.columns[id][at.row * componentSizes[id]], 0, componentSizes[id]);
+	}
+
+	EcsEntity entity;
+	entity.index = locations.insert(at, entity.generation);
+	chunk.entities[at.row] = entity;
+	return entity;
+}
+
+void ArchetypeStore::destroy(EcsEntity entity)
+{
+	Location* found = locations.get(entity.index, entity.generation);
+	if (found == nullptr)
+		return;
+	Location at = *found;
+	Archetype& archetype = archetypes[at.archetype];
+	Chunk& chunk = archetype.chunks[at.chunk];
+
+	//the chunk's last row fills the hole so the arrays stay packed
+	int last = (int)chunk.count - 1;
+	if (at.row != last) {
+		for (int id = 0; id < maxComponentTypes; id++) {
+			if (archetype.mask & (1u << id)) {
+				size_t size = componentSizes[id];
+				std::memcpy(&chunk.columns[id][at.row * size], &chunk.columns[id][last * size], size);
+			}
+		}
+		EcsEntity moved = chunk.entities[last];
+		chunk.entities[at.row] = moved;
+		locations.at(moved.index)->row = at.row;
+	}
+	chunk.count--;
+	if ((size_t)at.chunk < archetype.open)
+		archetype.open = at.chunk;
+	locations.erase(entity.index);
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include "SlotMap.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+/*************************************************
+
+	Archetype entity-component storage
+
+	An entity is a set of plain-data components.
+	Entities with exactly the same set of
+	component types share an archetype, and an
+	archetype stores them in chunks of
+	chunkCapacity rows. Each chunk has one
+	contiguous array per component type, so a
+	system that needs Transform and Motion walks
+	two flat arrays, and it never visits entities
+	that lack either one.
+
+	Removing an entity moves the chunk's last row
+	into its place. Entities are referred to by
+	EcsEntity handles, which go stale once the
+	entity is destroyed.
+
+	Do not create or destroy entities inside
+	forEachChunk(); collect them and apply the
+	changes after the walk.
+
+**************************************************/
+
+typedef uint32_t ComponentMask;
+const int maxComponentTypes = 32;
+
+//hands out the next component type id; called once per type by componentId()
+int registerComponentType(size_t size);
+
+template <typename T>
+int componentId()
+{
+	static_assert(std::is_trivially_copyable<T>::value, "components are moved with memcpy");
+	static const int id = registerComponentType(sizeof(T));
+	return id;
+}
+
+template <typename... Ts>
+ComponentMask componentMask()
+{
+	ComponentMask mask = 0;
+	int expand[] = { 0, (mask |= 1u << componentId<Ts>(), 0)... };
+	(void)expand;
+	return mask;
+}
+
+struct EcsEntity
+{
+	unsigned int index;
+	unsigned int generation;
+};
+
+class ArchetypeStore
+{
+public:
+	static const size_t chunkCapacity = 1024;
+
+private:
+	struct Chunk {
+		size_t count;
+		std::vector<EcsEntity> entities;
+		std::vector<unsigned char> columns[maxComponentTypes];	//empty for types the archetype lacks
+	};
+
+	struct Archetype {
+		ComponentMask mask;
+		std::vector<Chunk> chunks;
+		size_t open;	//first chunk that may have a free row
+	};
+
+	struct Location {
+		int archetype;
+		int chunk;
+		int row;
+	};
+
+	std::vector<Archetype> archetypes;
+	SlotMap<Location> locations;
+
+	int archetypeFor(ComponentMask mask);
+	void* component(const Location& at, int id);
+
+public:
+	//a new entity with every component in mask, zero-filled
+	EcsEntity create(ComponentMask mask);
+
+	void destroy(EcsEntity entity);
+
+	bool alive(EcsEntity entity)
+	{
+		return locations.get(entity.index, entity.generation) != nullptr;
+	}
+
+	//the entity's T, or nullptr if the entity is gone or has no T
+	template <typename T>
+	T* get(EcsEntity entity)
+	{
+		Location* at = locations.get(entity.index, entity.generation);
+		return at != nullptr ? static_cast<T*>(component(*at, componentId<T>())) : nullptr;
+	}
+
+	//calls fn(count, entities, Ts* ...) once per non-empty chunk whose archetype has every Ts
+	template <typename... Ts, typename F>
+	void forEachChunk(F fn)
+	{
+		ComponentMask mask = componentMask<Ts...>();
+		for (Archetype& archetype : archetypes) {
+			if ((archetype.mask & mask) != mask)
+				continue;
+			for (Chunk& chunk : archetype.chunks) {
+				if (chunk.count > 0)
+					fn(chunk.count, chunk.entities.data(), reinterpret_cast<Ts*>(chunk.columns[componentId<Ts>()].data())...);
+			}
+		}
+	}
+
+	size_t size() const
+	{
+		return locations.size();
+	}
+
+	size_t archetypeCount() const
+	{
+		return archetypes.size();
+	}
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+/*************************************************
+
+	Command-line benchmarks
+
+	Each runs on its own, prints what it measured
+	and returns the process exit code. main()
+	only picks one from the command line.
+
+**************************************************/
+
+//the bullet-vs-enemy narrowphase: aabbOverlap() per pair against every kernel level this CPU runs
+int runAabbBenchmark();
+
+//the movement and collision passes over a vector of GameObject and over an EntityStore
+int runSoaBenchmark(int entities);
+
+//collision responses picked by dynamic_cast chains and by the (self, other) tag table
+int runDispatchBenchmark(int tanks);
+
+//the tank/bullet game through the archetype store and through virtual calls on shared_ptr objects
+int runEcsBenchmark(int entities);
+
+//a scene's worth of tank transforms: the hierarchy's cached world matrices checked, then update() timed
+int runTransformBenchmark(int tanks);
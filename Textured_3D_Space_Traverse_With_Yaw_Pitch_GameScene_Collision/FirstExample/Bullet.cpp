@@ -1,8 +1,14 @@
 //I promise to work on this exam on my own without receiving any help from any other persons. All of my answers will be my own.
 
 #include "Bullet.h"
+#include "GameScene.h"
 #include "glm\glm.hpp"
 
+GameObject* Bullet::getSource()
+{
+	return gameScene.get(source);
+}
+
 GLfloat Bullet::vertexMesh[][3] = {
 	{ 0.5, 0.5 ,0.0 }, { -0.5, 0.5 ,0.0 }, { -0.5, -0.5 ,0.0 }, { 0.5, -0.5 ,0.0 },
 	{ 0.5, 0.5 ,1.0 }, { -0.5, 0.5 ,1.0 }, { -0.5, -0.5 ,1.0 }, { 0.5, -0.5 ,1.0},
@@ -15,6 +15,7 @@
 #include "glm\gtx\rotate_vector.hpp"
 #include <iostream>
 #include "Texture.h"
+#include "Meshes.h"
 
 
 class Bullet : public GameObject
@@ -22,11 +23,12 @@ class Bullet : public GameObject
 	static GLfloat vertexMesh[24][3];
 	static GLfloat textureMesh[24][2];
 	int spawnedTime = 0; // time when the bullet was spawned
-	GameObject* source { nullptr }; //pointer to the source of the bullet (was fired by X)
+	ObjectHandle source; //handle to the source of the bullet (was fired by X); stops resolving once X is erased
 public:
-	Bullet(glm::vec3 loc, glm::vec3 dir, GameObject* src = nullptr) : GameObject(loc, dir) {
+	Bullet(glm::vec3 loc, glm::vec3 dir, ObjectHandle src = ObjectHandle()) : GameObject(loc, dir) {
 		setDimensions(0.25, 0.25, 0.25);
 		setMoveSpeed(10.f);
+		setTag(TAG_BULLET);
 		source = src;
 		spawnedTime = glutGet(GLUT_ELAPSED_TIME);
 	};
@@ -37,14 +39,16 @@ public:
 		setPosition(getPosition() + (getDirection() * (getMoveSpeed() * deltaTime / 1000.f)));
 	}
 
+	//uploads the bullet mesh once; call at startup, after the GL context exists
+	static void initMesh()
+	{
+		Meshes::add(MeshID::bulletMesh, GL_QUADS, vertexMesh, textureMesh, 24);
+	}
+
 	//draws the bullet
 	virtual void draw()
 	{	
-		
-		glBindBuffer(GL_ARRAY_BUFFER, Buffers[0]);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(vertexMesh), vertexMesh, GL_STATIC_DRAW);
-		glBindBuffer(GL_ARRAY_BUFFER, Buffers[1]);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(textureMesh), textureMesh, GL_STATIC_DRAW);
+		Meshes::get(MeshID::bulletMesh).bind();
 
 		glm::mat4 model_view = glm::mat4(1);
 
@@ -53,6 +57,7 @@ public:
 		glUniformMatrix4fv(location, 1, GL_FALSE, &model_view[0][0]);
 		glBindTexture(GL_TEXTURE_2D, Texture::get(TextureID::bullet));
 		glDrawArrays(GL_QUADS, 0, 24);
+		glBindVertexArray(0);
 	}
 
 	//idle
@@ -60,11 +65,10 @@ public:
 	{
 		if (glutGet(GLUT_ELAPSED_TIME) - spawnedTime >= 2000) //if 2 seconds have passed since the bullet's spawn
 			willBeErased = true; //mark the object for erasure 
-		if (source != nullptr && source->willBeErased) //disassociate from the source if the source will be deleted (idle check is done before deletion check); may run into issues when there is willBeErased is marked at the idle check, but that is out of the scope of this work for now.
-			source = nullptr;
 	}
 
-	inline GameObject* getSource() {return source;}
+	//the object that fired this bullet, or nullptr if it has been erased since
+	GameObject* getSource();
 
 	//collision detection
 	virtual void checkCollision(GameObject*) {};
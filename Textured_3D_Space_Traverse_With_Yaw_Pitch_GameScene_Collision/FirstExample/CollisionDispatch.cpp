@@ -0,0 +1,65 @@
+#include "CollisionDispatch.h"
+#include "Tank.h"
+#include "Player.h"
+#include "Bullet.h"
+#include <cassert>
+
+extern int gs; //gamestate
+
+//DispatchBenchmark.cpp mirrors these handlers and the table below for --bench-dispatch;
+//a change to either has to be made there as well
+
+//a tank that drives into the player is destroyed
+static void tankTouchesPlayer(GameObject* self, GameObject* other)
+{
+	if (self->isColliding(other))
+		self->willBeErased = true; //mark the object for deletion
+}
+
+//only the player's bullets destroy tanks
+static void tankTouchesBullet(GameObject* self, GameObject* other)
+{
+	GameObject* source = static_cast<Bullet*>(other)->getSource();
+	if (source == nullptr || source->getTag() != TAG_PLAYER)
+		return;
+
+	if (self->isColliding(other)) {
+		self->willBeErased = true; //mark the object for deletion
+		assert(dynamic_cast<Player*>(source) != nullptr); //TAG_PLAYER must only ever be set by Player
+		static_cast<Player*>(source)->incTanksShot(); //increment number of tanks shot
+	}
+}
+
+//a tank's bullet reaching the player ends the game
+static void playerTouchesBullet(GameObject* self, GameObject* other)
+{
+	GameObject* source = static_cast<Bullet*>(other)->getSource();
+	if (source == nullptr || source->getTag() != TAG_TANK)
+		return;
+
+	if (self->isColliding(other))
+		gs = 2; //defeat
+}
+
+struct CollisionTable
+{
+	CollisionHandler handlers[TAG_COUNT][TAG_COUNT];
+};
+
+static constexpr CollisionTable buildCollisionTable()
+{
+	CollisionTable table{};
+	table.handlers[TAG_TANK][TAG_PLAYER] = tankTouchesPlayer;
+	table.handlers[TAG_TANK][TAG_BULLET] = tankTouchesBullet;
+	table.handlers[TAG_PLAYER][TAG_BULLET] = playerTouchesBullet;
+	return table;
+}
+
+static constexpr CollisionTable collisionTable = buildCollisionTable();
+
+void respondToCollision(GameObject* self, GameObject* other)
+{
+	CollisionHandler handler = collisionTable.handlers[self->getTag()][other->getTag()];
+	if (handler != nullptr)
+		handler(self, other);
+}
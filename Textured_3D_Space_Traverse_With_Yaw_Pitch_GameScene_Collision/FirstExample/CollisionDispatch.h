@@ -0,0 +1,19 @@
+#pragma once
+#include "GameObject.h"
+
+/*************************************************
+
+	Collision responses by type tag
+
+	Every (self, other) pair of object tags maps
+	to a response handler in a table that is
+	filled in at compile time. Pairs without a
+	response have an empty entry and are dropped
+	before any overlap test is done.
+
+**************************************************/
+
+typedef void (*CollisionHandler)(GameObject* self, GameObject* other);
+
+//runs self's response to touching other, if that pair of types has one
+void respondToCollision(GameObject* self, GameObject* other);
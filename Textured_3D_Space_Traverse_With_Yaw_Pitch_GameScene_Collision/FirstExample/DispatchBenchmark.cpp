@@ -0,0 +1,167 @@
+#include "Benchmarks.h"
+#include "World.h"
+#include <cstdio>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+
+// Stand-ins for Player, Tank and Bullet as --bench-dispatch runs them. Tank.cpp and Player.h build
+// against the old GameObject class, not this tree's, so their collision code is mirrored here: the
+// dynamic_cast chains they used to run, and the tag table CollisionDispatch.cpp replaced them with.
+// Both paths see every ordered pair of objects, the way the scene loop calls checkCollision().
+
+enum DispatchTag : unsigned char { DISPATCH_NONE, DISPATCH_PLAYER, DISPATCH_TANK, DISPATCH_BULLET, DISPATCH_TAG_COUNT };
+
+struct DispatchOutcome {
+    int tanksShot = 0;
+    int gameState = 0;  // 2 = defeat, as gs in the game
+};
+
+struct DispatchObject {
+    DispatchTag tag = DISPATCH_NONE;
+    glm::vec3 position;
+    float size;
+    bool willBeErased = false;
+    DispatchObject* source = nullptr;  // bullets only: who fired
+    DispatchOutcome* outcome = nullptr;
+    virtual ~DispatchObject() {}
+    bool isColliding(const DispatchObject* other) const { return aabbOverlap(position, size, other->position, other->size); }
+    virtual void checkCollision(DispatchObject*) {}  // the old dynamic_cast responses
+};
+
+struct DispatchPlayer : DispatchObject {
+    DispatchPlayer() { tag = DISPATCH_PLAYER; }
+    void checkCollision(DispatchObject* other) override;
+};
+
+struct DispatchBullet : DispatchObject {
+    DispatchBullet() { tag = DISPATCH_BULLET; }
+};
+
+struct DispatchTank : DispatchObject {
+    DispatchTank() { tag = DISPATCH_TANK; }
+    void checkCollision(DispatchObject* other) override {
+        if (auto player = dynamic_cast<DispatchPlayer*>(other)) {
+            if (isColliding(player))
+                willBeErased = true;
+        }
+        else if (auto bullet = dynamic_cast<DispatchBullet*>(other)) {
+            if (isColliding(bullet) && bullet->source != nullptr) {
+                if (dynamic_cast<DispatchPlayer*>(bullet->source)) {
+                    willBeErased = true;
+                    outcome->tanksShot++;
+                }
+            }
+        }
+    }
+};
+
+void DispatchPlayer::checkCollision(DispatchObject* other) {
+    if (auto bullet = dynamic_cast<DispatchBullet*>(other)) {
+        if (isColliding(bullet) && bullet->source != nullptr && dynamic_cast<DispatchTank*>(bullet->source))
+            outcome->gameState = 2;
+    }
+}
+
+// The tag table path, handler for handler as in CollisionDispatch.cpp
+typedef void (*DispatchHandler)(DispatchObject* self, DispatchObject* other);
+
+static void tankTouchesPlayer(DispatchObject* self, DispatchObject* other) {
+    if (self->isColliding(other))
+        self->willBeErased = true;
+}
+
+static void tankTouchesBullet(DispatchObject* self, DispatchObject* other) {
+    if (other->source == nullptr || other->source->tag != DISPATCH_PLAYER)
+        return;
+    if (self->isColliding(other)) {
+        self->willBeErased = true;
+        self->outcome->tanksShot++;
+    }
+}
+
+static void playerTouchesBullet(DispatchObject* self, DispatchObject* other) {
+    if (other->source == nullptr || other->source->tag != DISPATCH_TANK)
+        return;
+    if (self->isColliding(other))
+        self->outcome->gameState = 2;
+}
+
+struct DispatchTable {
+    DispatchHandler handlers[DISPATCH_TAG_COUNT][DISPATCH_TAG_COUNT];
+};
+
+static constexpr DispatchTable buildDispatchTable() {
+    DispatchTable table{};
+    table.handlers[DISPATCH_TANK][DISPATCH_PLAYER] = tankTouchesPlayer;
+    table.handlers[DISPATCH_TANK][DISPATCH_BULLET] = tankTouchesBullet;
+    table.handlers[DISPATCH_PLAYER][DISPATCH_BULLET] = playerTouchesBullet;
+    return table;
+}
+
+static constexpr DispatchTable dispatchTable = buildDispatchTable();
+
+// One player, then tanks and bullets in equal numbers crowded together so plenty of pairs touch;
+// half the bullets are the player's, the rest come from random tanks
+static void buildDispatchScene(int tanks, DispatchOutcome* outcome, std::vector<std::unique_ptr<DispatchObject>>& objects) {
+    WorldRandom rng;
+    rng.seed(1);
+    float area = std::sqrt((float)tanks) * 0.5f;
+    objects.push_back(std::unique_ptr<DispatchObject>(new DispatchPlayer()));
+    for (int i = 0; i < tanks; i++)
+        objects.push_back(std::unique_ptr<DispatchObject>(new DispatchTank()));
+    for (int i = 0; i < tanks; i++) {
+        DispatchBullet* bullet = new DispatchBullet();
+        bullet->source = i % 2 == 0 ? objects[0].get() : objects[1 + rng.next() % tanks].get();
+        objects.push_back(std::unique_ptr<DispatchObject>(bullet));
+    }
+    for (std::unique_ptr<DispatchObject>& o : objects) {
+        o->position = glm::vec3(rng.uniform(-area, area), rng.uniform(-area, area), 0.5f);
+        o->size = o->tag == DISPATCH_BULLET ? 0.25f : 1.0f;
+        o->outcome = outcome;
+    }
+}
+
+int runDispatchBenchmark(int tanks) {
+    tanks = std::max(1, tanks);
+
+    DispatchOutcome rttiOutcome, tableOutcome;
+    std::vector<std::unique_ptr<DispatchObject>> rttiScene, tableScene;
+    buildDispatchScene(tanks, &rttiOutcome, rttiScene);
+    buildDispatchScene(tanks, &tableOutcome, tableScene);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t a = 0; a < rttiScene.size(); a++)
+        for (size_t b = 0; b < rttiScene.size(); b++)
+            if (a != b)
+                rttiScene[a]->checkCollision(rttiScene[b].get());
+    double rttiMs = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    for (size_t a = 0; a < tableScene.size(); a++) {
+        DispatchObject* self = tableScene[a].get();
+        for (size_t b = 0; b < tableScene.size(); b++) {
+            DispatchObject* other = tableScene[b].get();
+            DispatchHandler handler = dispatchTable.handlers[self->tag][other->tag];
+            if (a != b && handler != nullptr)
+                handler(self, other);
+        }
+    }
+    double tableMs = elapsedMs(start);
+
+    int rttiErased = 0, tableErased = 0;
+    bool same = rttiOutcome.tanksShot == tableOutcome.tanksShot && rttiOutcome.gameState == tableOutcome.gameState;
+    for (size_t i = 0; i < rttiScene.size(); i++) {
+        rttiErased += rttiScene[i]->willBeErased ? 1 : 0;
+        tableErased += tableScene[i]->willBeErased ? 1 : 0;
+        same = same && rttiScene[i]->willBeErased == tableScene[i]->willBeErased;
+    }
+
+    double pairs = (double)rttiScene.size() * (rttiScene.size() - 1);
+    printf("%d tanks, %d bullets, 1 player: %.0f ordered pairs, %d tanks erased, %d shot by the player, %s%s\n",
+        tanks, tanks, pairs, tableErased, tableOutcome.tanksShot, tableOutcome.gameState == 2 ? "defeat" : "still playing",
+        same ? "" : " (MISMATCH)");
+    printf("  dynamic_cast %.3f ms (%.2f ns per pair), tag table %.3f ms (%.2f ns per pair) (%.2fx)\n",
+        rttiMs, rttiMs * 1e6 / pairs, tableMs, tableMs * 1e6 / pairs, rttiMs / std::max(tableMs, 1e-9));
+    return same ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+#include "Benchmarks.h"
+#include "World.h"
+#include "ArchetypeStore.h"
+#include "EcsSystems.h"
+#include "glm\gtc\matrix_transform.hpp"
+#include <cstdio>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+
+// Stand-ins for Tank and Bullet as --bench-ecs runs them: one heap object per entity behind a
+// shared_ptr, with updatePosition(), idle() and draw() as virtual calls
+struct BenchObject {
+    glm::vec3 position;
+    glm::vec3 direction;
+    float speed;
+    bool willBeErased = false;
+    virtual ~BenchObject() {}
+    virtual void updatePosition(float deltaMs) { position += direction * (speed * deltaMs / 1000.f); }
+    virtual void idle(int now, glm::vec3 target, std::vector<std::shared_ptr<BenchObject>>& spawned) = 0;
+    virtual void draw(std::vector<DrawItem>& out) = 0;
+};
+
+struct BenchBullet : BenchObject {
+    int spawnedTime;
+    BenchBullet(glm::vec3 loc, glm::vec3 dir, int now) : spawnedTime(now) { position = loc; direction = dir; speed = 10.f; }
+    void idle(int now, glm::vec3, std::vector<std::shared_ptr<BenchObject>>&) override {
+        if (now - spawnedTime >= 2000)
+            willBeErased = true;
+    }
+    void draw(std::vector<DrawItem>& out) override {
+        DrawItem item;
+        item.model = glm::translate(glm::mat4(1), position);
+        item.model = glm::rotate(item.model, std::atan2(-direction.x, direction.y), glm::vec3(0, 0, 1));
+        item.model = glm::scale(item.model, glm::vec3(0.25f));
+        item.mesh = MESH_BULLET;
+        item.texture = 0;
+        out.push_back(item);
+    }
+};
+
+struct BenchTank : BenchObject {
+    int lastBulletShot;
+    BenchTank(glm::vec3 loc, glm::vec3 dir, float spd, int now) : lastBulletShot(now) { position = loc; direction = dir; speed = spd; }
+    void idle(int now, glm::vec3 target, std::vector<std::shared_ptr<BenchObject>>& spawned) override {
+        if (now - lastBulletShot <= 1000)
+            return;
+        glm::vec3 aim = target - position;
+        float length = glm::length(aim);
+        spawned.push_back(std::shared_ptr<BenchObject>(new BenchBullet(position, length > 0.0f ? aim / length : glm::vec3(0), now)));
+        lastBulletShot = now;
+    }
+    void draw(std::vector<DrawItem>& out) override {
+        DrawItem item;
+        item.model = glm::translate(glm::mat4(1), position);
+        item.model = glm::rotate(item.model, std::atan2(-direction.x, direction.y), glm::vec3(0, 0, 1));
+        item.model = glm::scale(item.model, glm::vec3(2.0f));
+        item.mesh = MESH_TANK;
+        item.texture = 0;
+        out.push_back(item);
+    }
+};
+
+// Runs the same tank/bullet game through the archetype store and through virtual calls on
+// shared_ptr objects, and reports the cost of each phase per frame
+int runEcsBenchmark(int entities) {
+    const int frames = 120;
+    const float frameMs = 16.0f;
+    const glm::vec3 target(0, 0, 0.5f);
+    WorldRandom rng;
+    rng.seed(1);
+
+    // A third tanks, the rest bullets: one shot a second living two seconds keeps that ratio
+    ArchetypeStore store;
+    std::vector<std::shared_ptr<BenchObject>> objects;
+    int tanks = entities / 3;
+    for (int i = 0; i < entities; i++) {
+        glm::vec3 position(rng.uniform(-100, 100), rng.uniform(-100, 100), 0.5f);
+        glm::vec3 direction = glm::normalize(glm::vec3(rng.uniform(-1, 1), rng.uniform(-1, 1), 0.0f) + glm::vec3(1e-3f, 0, 0));
+        if (i < tanks) {
+            float speed = rng.uniform(0.75f, 1.25f);
+            int lastShot = -(int)rng.uniform(0, 1000);
+            spawnTank(store, position, direction, speed, lastShot);
+            objects.push_back(std::shared_ptr<BenchObject>(new BenchTank(position, direction, speed, lastShot)));
+        }
+        else {
+            int spawned = -(int)rng.uniform(0, 2000);
+            spawnBullet(store, position, direction, spawned);
+            objects.push_back(std::shared_ptr<BenchObject>(new BenchBullet(position, direction, spawned)));
+        }
+    }
+
+    double ecsMs[4] = { 0, 0, 0, 0 }, virtualMs[4] = { 0, 0, 0, 0 };
+    size_t ecsDrawn = 0, virtualDrawn = 0;
+    std::vector<DrawItem> drawList;
+    std::vector<std::shared_ptr<BenchObject>> spawned;
+    for (int frame = 1; frame <= frames; frame++) {
+        int now = (int)(frame * frameMs);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        movementSystem(store, frameMs);
+        ecsMs[0] += elapsedMs(start);
+        start = std::chrono::steady_clock::now();
+        firingSystem(store, now, target);
+        ecsMs[1] += elapsedMs(start);
+        start = std::chrono::steady_clock::now();
+        lifetimeSystem(store, now);
+        ecsMs[2] += elapsedMs(start);
+        start = std::chrono::steady_clock::now();
+        renderSystem(store, drawList);
+        ecsMs[3] += elapsedMs(start);
+        ecsDrawn += drawList.size();
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < objects.size(); i++)
+            objects[i]->updatePosition(frameMs);
+        virtualMs[0] += elapsedMs(start);
+        start = std::chrono::steady_clock::now();
+        spawned.clear();
+        for (size_t i = 0; i < objects.size(); i++)
+            objects[i]->idle(now, target, spawned);
+        objects.insert(objects.end(), spawned.begin(), spawned.end());
+        virtualMs[1] += elapsedMs(start);
+        start = std::chrono::steady_clock::now();
+        objects.erase(std::remove_if(objects.begin(), objects.end(),
+            [](const std::shared_ptr<BenchObject>& o) { return o->willBeErased; }), objects.end());
+        virtualMs[2] += elapsedMs(start);
+        start = std::chrono::steady_clock::now();
+        drawList.clear();
+        for (size_t i = 0; i < objects.size(); i++)
+            objects[i]->draw(drawList);
+        virtualMs[3] += elapsedMs(start);
+        virtualDrawn += drawList.size();
+    }
+
+    const char* phases[4] = { "movement", "firing", "lifetime", "render" };
+    printf("%d entities, %d frames: archetype store ends with %zu in %zu archetypes, class hierarchy with %zu%s\n",
+        entities, frames, store.size(), store.archetypeCount(), objects.size(),
+        ecsDrawn == virtualDrawn && store.size() == objects.size() ? "" : " (MISMATCH)");
+    double ecsTotal = 0, virtualTotal = 0;
+    for (int p = 0; p < 4; p++) {
+        printf("  %-8s  archetype %.3f ms/frame, virtual %.3f ms/frame\n", phases[p], ecsMs[p] / frames, virtualMs[p] / frames);
+        ecsTotal += ecsMs[p];
+        virtualTotal += virtualMs[p];
+    }
+    printf("  total     archetype %.3f ms/frame, virtual %.3f ms/frame (%.2fx)\n",
+        ecsTotal / frames, virtualTotal / frames, virtualTotal / std::max(ecsTotal, 1e-9));
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include "EcsSystems.h"
+#include "glm\gtc\matrix_transform.hpp"
+#include <cmath>
+
+//same cadence and lifetime as Tank and Bullet
+const int tankFireInterval = 1000;
+const int bulletLifeSpan = 2000;
+const float bulletSpeed = 10.0f;
+
+EcsEntity spawnTank(ArchetypeStore& store, glm::vec3 position, glm::vec3 direction, float speed, int now)
+{
+	EcsEntity tank = store.create(componentMask<Transform, Motion, Shooter, Renderable>());
+	*store.get<Transform>(tank) = Transform{ position, direction };
+	store.get<Motion>(tank)->speed = speed;
+	*store.get<Shooter>(tank) = Shooter{ now, tankFireInterval };
+	*store.get<Renderable>(tank) = Renderable{ MESH_TANK, 2.0f, 0 };
+	return tank;
+}
+
+EcsEntity spawnBullet(ArchetypeStore& store, glm::vec3 position, glm::vec3 direction, int now)
+{
+	EcsEntity bullet = store.create(componentMask<Transform, Motion, Lifetime, Renderable>());
+	*store.get<Transform>(bullet) = Transform{ position, direction };
+	store.get<Motion>(bullet)->speed = bulletSpeed;
+	*store.get<Lifetime>(bullet) = Lifetime{ now, bulletLifeSpan };
+	*store.get<Renderable>(bullet) = Renderable{ MESH_BULLET, 0.25f, 0 };
+	return bullet;
+}
+
+void movementSystem(ArchetypeStore& store, float deltaMs)
+{
+	float seconds = deltaMs / 1000.f;
+	store.forEachChunk<Transform, Motion>([seconds](size_t n, const EcsEntity*, Transform* transform, Motion* motion) {
+		for (size_t i = 0; i < n; i++)
+			transform[i].position += transform[i].direction * (motion[i].speed * seconds);
+	});
+}
+
+int firingSystem(ArchetypeStore& store, int now, glm::vec3 target)
+{
+	std::vector<Transform> shots;
+	store.forEachChunk<Transform, Shooter>([&](size_t n, const EcsEntity*, Transform* transform, Shooter* shooter) {
+		for (size_t i = 0; i < n; i++) {
+			if (now - shooter[i].lastShot <= shooter[i].interval)
+				continue;
+			glm::vec3 aim = target - transform[i].position;
+			float length = glm::length(aim);
+			shots.push_back(Transform{ transform[i].position, length > 0.0f ? aim / length : glm::vec3(0) });
+			shooter[i].lastShot = now;
+		}
+	});
+
+	//spawned after the walk; creating entities can move the chunks being walked
+	for (const Transform& shot : shots)
+		spawnBullet(store, shot.position, shot.direction, now);
+	return (int)shots.size();
+}
+
+int lifetimeSystem(ArchetypeStore& store, int now)
+{
+	std::vector<EcsEntity> expired;
+	store.forEachChunk<Lifetime>([&](size_t n, const EcsEntity* entities, Lifetime* lifetime) {
+		for (size_t i = 0; i < n; i++) {
+			if (now - lifetime[i].spawnedTime >= lifetime[i].span)
+				expired.push_back(entities[i]);
+		}
+	});
+
+	for (EcsEntity entity : expired)
+		store.destroy(entity);
+	return (int)expired.size();
+}
+
+void renderSystem(ArchetypeStore& store, std::vector<DrawItem>& out)
+{
+	out.clear();
+	store.forEachChunk<Transform, Renderable>([&](size_t n, const EcsEntity*, Transform* transform, Renderable* renderable) {
+		for (size_t i = 0; i < n; i++) {
+			DrawItem item;
+			item.model = glm::translate(glm::mat4(1), transform[i].position);
+			item.model = glm::rotate(item.model, std::atan2(-transform[i].direction.x, transform[i].direction.y), glm::vec3(0, 0, 1));
+			item.model = glm::scale(item.model, glm::vec3(renderable[i].scale));
+			item.mesh = renderable[i].mesh;
+			item.texture = renderable[i].texture;
+			out.push_back(item);
+		}
+	});
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "vgl.h"
+#include "glm\glm.hpp"
+#include "ArchetypeStore.h"
+#include <vector>
+
+/*************************************************
+
+	Components and systems for the tank game on
+	top of ArchetypeStore
+
+	These mirror what Tank and Bullet do through
+	virtual calls: movement is updatePosition(),
+	firing and lifetime are idle(), rendering is
+	draw(). They sit beside the class hierarchy
+	while it is migrated. A tank is Transform +
+	Motion + Shooter + Renderable; a bullet swaps
+	Shooter for Lifetime.
+
+	Times are in ms and passed in, so the systems
+	run the same with or without a window.
+
+**************************************************/
+
+enum Ecs_Mesh {
+	MESH_TANK,
+	MESH_BULLET
+};
+
+struct Transform {
+	glm::vec3 position;
+	glm::vec3 direction;	//unit length, or zero
+};
+
+struct Motion {
+	float speed;	//units per second along the direction
+};
+
+struct Lifetime {
+	int spawnedTime;
+	int span;	//erased once this many ms have passed
+};
+
+struct Shooter {
+	int lastShot;
+	int interval;	//fires when more than this many ms have passed since lastShot
+};
+
+struct Renderable {
+	int mesh;
+	float scale;
+	GLuint texture;
+};
+
+struct DrawItem {
+	glm::mat4 model;
+	int mesh;
+	GLuint texture;
+};
+
+EcsEntity spawnTank(ArchetypeStore& store, glm::vec3 position, glm::vec3 direction, float speed, int now);
+EcsEntity spawnBullet(ArchetypeStore& store, glm::vec3 position, glm::vec3 direction, int now);
+
+//moves everything with Transform and Motion along its direction
+void movementSystem(ArchetypeStore& store, float deltaMs);
+
+//every Shooter whose interval has run out fires a bullet at target; returns how many were fired
+int firingSystem(ArchetypeStore& store, int now, glm::vec3 target);
+
+//destroys everything whose Lifetime has run out; returns how many were destroyed
+int lifetimeSystem(ArchetypeStore& store, int now);
+
+//one model matrix per Renderable, in the order the chunks are stored
+void renderSystem(ArchetypeStore& store, std::vector<DrawItem>& out);
@@ -0,0 +1,139 @@
+#include "EntityStore.h"
+
+EntityHandle EntityStore::spawn(const GameObject& go)
+{
+	int slot;
+	if (!freeSlots.empty()) {
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else {
+		slot = (int)entityOfSlot.size();
+		entityOfSlot.push_back(-1);
+		slotGeneration.push_back(0);
+	}
+	entityOfSlot[slot] = (int)size();
+	slotOfEntity.push_back(slot);
+
+	location.push_back(go.location);
+	moving_direction.push_back(go.moving_direction);
+	velocity.push_back(go.velocity);
+	collider_dimension.push_back(go.collider_dimension);
+	isAlive.push_back(go.isAlive);
+	isCollided.push_back(go.isCollided);
+	type.push_back(go.type);
+	living_time.push_back(go.living_time);
+	life_span.push_back(go.life_span);
+	lastUpdateTime.push_back(go.lastUpdateTime);
+	nextUpdateTime.push_back(go.lastUpdateTime);
+	updateBand.push_back(0);
+
+	rotation.push_back(go.rotation);
+	scale.push_back(go.scale);
+	textureID.push_back(go.textureID);
+	lastShotTime.push_back(go.lastShotTime);
+	owner.push_back(go.owner);
+	previous_location.push_back(go.location);
+	return EntityHandle{ slot, slotGeneration[slot] };
+}
+
+void EntityStore::moveEntity(size_t from, size_t to)
+{
+	location[to] = location[from];
+	moving_direction[to] = moving_direction[from];
+	velocity[to] = velocity[from];
+	collider_dimension[to] = collider_dimension[from];
+	isAlive[to] = isAlive[from];
+	isCollided[to] = isCollided[from];
+	type[to] = type[from];
+	living_time[to] = living_time[from];
+	life_span[to] = life_span[from];
+	lastUpdateTime[to] = lastUpdateTime[from];
+	nextUpdateTime[to] = nextUpdateTime[from];
+	updateBand[to] = updateBand[from];
+
+	rotation[to] = rotation[from];
+	scale[to] = scale[from];
+	textureID[to] = textureID[from];
+	lastShotTime[to] = lastShotTime[from];
+	owner[to] = owner[from];
+	previous_location[to] = previous_location[from];
+
+	slotOfEntity[to] = slotOfEntity[from];
+	entityOfSlot[slotOfEntity[to]] = (int)to;
+}
+
+size_t EntityStore::reclaimDead()
+{
+	size_t count = size();
+	size_t kept = 0;
+	for (size_t i = 0; i < count; i++) {
+		if (!isAlive[i]) {
+			entityOfSlot[slotOfEntity[i]] = -1;
+			slotGeneration[slotOfEntity[i]]++;
+			freeSlots.push_back(slotOfEntity[i]);
+			continue;
+		}
+		if (kept != i)
+			moveEntity(i, kept);
+		kept++;
+	}
+
+	location.resize(kept);
+	moving_direction.resize(kept);
+	velocity.resize(kept);
+	collider_dimension.resize(kept);
+	isAlive.resize(kept);
+	isCollided.resize(kept);
+	type.resize(kept);
+	living_time.resize(kept);
+	life_span.resize(kept);
+	lastUpdateTime.resize(kept);
+	nextUpdateTime.resize(kept);
+	updateBand.resize(kept);
+
+	rotation.resize(kept);
+	scale.resize(kept);
+	textureID.resize(kept);
+	lastShotTime.resize(kept);
+	owner.resize(kept);
+	previous_location.resize(kept);
+
+	slotOfEntity.resize(kept);
+	return count - kept;
+}
+
+//counts the arrays whose length differs from the entity count
+struct EntityArraySizeCheck
+{
+	size_t entities;
+	int mismatched;
+
+	template <typename T>
+	void operator()(const std::vector<T>& v) { mismatched += v.size() != entities ? 1 : 0; }
+};
+
+bool EntityStore::isConsistent() const
+{
+	EntityArraySizeCheck check{ size(), 0 };
+	visitEntityArraysOf(*this, check);
+	if (check.mismatched != 0 || slotOfEntity.size() != size() || slotGeneration.size() != entityOfSlot.size())
+		return false;
+
+	//every slot is either held by exactly one live entity or free exactly once
+	size_t slots = entityOfSlot.size();
+	if (size() + freeSlots.size() != slots)
+		return false;
+	for (size_t i = 0; i < size(); i++) {
+		int slot = slotOfEntity[i];
+		if (slot < 0 || (size_t)slot >= slots || entityOfSlot[slot] != (int)i)
+			return false;
+	}
+	std::vector<uint8_t> freed(slots, 0);
+	for (int slot : freeSlots) {
+		if (slot < 0 || (size_t)slot >= slots || entityOfSlot[slot] != -1 || freed[slot])
+			return false;
+		freed[slot] = 1;
+	}
+	return true;
+}
@@ -0,0 +1,148 @@
+#pragma once
+#include "vgl.h"
+#include "glm\glm.hpp"
+#include <vector>
+#include <cstdint>
+
+// === Game Object ===
+enum GameObject_Type {
+    PLAYER,
+    ENEMY,
+    BULLET,
+    OBSTACLE
+};
+
+//describes an object to spawn; EntityStore splits these fields over separate arrays
+struct GameObject {
+    glm::vec3 location;
+    glm::vec3 rotation;
+    glm::vec3 scale;
+    glm::vec3 moving_direction;
+    GLfloat velocity;
+    GLfloat collider_dimension;
+    int living_time;
+    int life_span;
+    int type;
+    bool isAlive;
+    bool isCollided;
+    GLuint textureID;
+    int lastShotTime; // For enemy shooting cooldown
+    int owner; // 0 = player, 1 = enemy
+    int lastUpdateTime; // sim time the entity was last moved; far enemies skip ticks and catch up from here
+};
+
+//refers to one entity for as long as it lives; goes stale once the entity is reclaimed
+struct EntityHandle {
+    int slot;
+    unsigned int generation;
+};
+
+/*************************************************
+
+	Struct-of-arrays entity store
+
+	Each GameObject field lives in its own
+	contiguous array, so the movement and
+	collision loops only pull the fields they use
+	through the cache. Hot simulation fields are
+	kept apart from the cold render/gameplay ones.
+
+	Live entities stay densely packed; slot ids
+	stay valid while an entity lives and are
+	recycled through a free-list once it dies.
+	Each reuse bumps the slot's generation, so
+	handles to the previous occupant stop
+	resolving.
+
+**************************************************/
+
+class EntityStore
+{
+	std::vector<int> slotOfEntity;	//slot id of each dense entry
+	std::vector<int> entityOfSlot;	//dense index of each slot, -1 when the slot is free
+	std::vector<int> freeSlots;		//slot ids waiting to be reused
+	std::vector<unsigned int> slotGeneration; //bumped every time a slot is freed
+
+	void moveEntity(size_t from, size_t to);
+
+	template <typename Store, typename V>
+	static void visitArraysOf(Store& s, V& visit)
+	{
+		visit(s.slotOfEntity);
+		visit(s.entityOfSlot);
+		visit(s.freeSlots);
+		visit(s.slotGeneration);
+		visitEntityArraysOf(s, visit);
+	}
+
+	//the arrays with one entry per live entity
+	template <typename Store, typename V>
+	static void visitEntityArraysOf(Store& s, V& visit)
+	{
+		visit(s.location);
+		visit(s.moving_direction);
+		visit(s.velocity);
+		visit(s.collider_dimension);
+		visit(s.isAlive);
+		visit(s.isCollided);
+		visit(s.type);
+		visit(s.living_time);
+		visit(s.life_span);
+		visit(s.lastUpdateTime);
+		visit(s.nextUpdateTime);
+		visit(s.updateBand);
+		visit(s.rotation);
+		visit(s.scale);
+		visit(s.textureID);
+		visit(s.lastShotTime);
+		visit(s.owner);
+		visit(s.previous_location);
+	}
+
+public:
+	// hot: read by every movement and collision pass
+	std::vector<glm::vec3> location;
+	std::vector<glm::vec3> moving_direction;
+	std::vector<GLfloat> velocity;
+	std::vector<GLfloat> collider_dimension;
+	std::vector<uint8_t> isAlive;
+	std::vector<uint8_t> isCollided;
+	std::vector<int> type;
+	std::vector<int> living_time;
+	std::vector<int> life_span;
+	std::vector<int> lastUpdateTime;
+	std::vector<int> nextUpdateTime;	//sim time of the next update; ticks before it are skipped
+	std::vector<uint8_t> updateBand;	//distance band picked at the last update
+
+	// cold: only needed for rendering and gameplay rules
+	std::vector<glm::vec3> rotation;
+	std::vector<glm::vec3> scale;
+	std::vector<GLuint> textureID;
+	std::vector<int> lastShotTime;
+	std::vector<int> owner;
+	std::vector<glm::vec3> previous_location;	//location at the start of the current tick, for render interpolation
+
+	//adds an entity and returns a handle to it
+	EntityHandle spawn(const GameObject& go);
+
+	//stable compaction: drops dead entities, survivors keep their order; returns how many were removed
+	size_t reclaimDead();
+
+	//remembers where every entity is before the tick moves it
+	void storePreviousLocations() { previous_location = location; }
+
+	//dense index of the entity a handle refers to, -1 if it has been reclaimed
+	int find(EntityHandle h) const { return (h.slot >= 0 && h.slot < (int)entityOfSlot.size() && slotGeneration[h.slot] == h.generation) ? entityOfSlot[h.slot] : -1; }
+	EntityHandle handleOf(size_t i) const { return EntityHandle{ slotOfEntity[i], slotGeneration[slotOfEntity[i]] }; }
+
+	//calls visit(array) on every array, bookkeeping first, always in the same order; snapshots go through this
+	template <typename V> void visitArrays(V& visit) { visitArraysOf(*this, visit); }
+	template <typename V> void visitArrays(V& visit) const { visitArraysOf(*this, visit); }
+
+	//true when every per-entity array has size() entries and the slot bookkeeping maps live entities
+	//and free slots one to one; a store copied in from outside must pass before anything walks it
+	bool isConsistent() const;
+
+	size_t size() const { return location.size(); }
+	size_t slotCount() const { return entityOfSlot.size(); } //high-water mark of simultaneously live entities
+};
@@ -0,0 +1,118 @@
+#include "FlowField.h"
+#include <cmath>
+#include <algorithm>
+
+FlowField::FlowField(float cell)
+	: cellSize(cell), invCellSize(1.0f / cell), origin(0.0f), goalCell(0)
+{
+}
+
+void FlowField::setBounds(glm::vec2 min, glm::vec2 max)
+{
+	origin = min;
+	width = std::max(1, (int)std::ceil((max.x - min.x) * invCellSize));
+	height = std::max(1, (int)std::ceil((max.y - min.y) * invCellSize));
+
+	size_t cells = (size_t)width * height;
+	blocked.assign(cells, 0);
+	distance.assign(cells, -1);
+	flow.assign(cells, glm::vec2(0.0f));
+	hasGoal = false;
+}
+
+bool FlowField::cellOf(glm::vec2 p, glm::ivec2& cell) const
+{
+	cell = glm::ivec2(glm::floor((p - origin) * invCellSize));
+	return cell.x >= 0 && cell.y >= 0 && cell.x < width && cell.y < height;
+}
+
+void FlowField::block(glm::vec2 center, float halfExtent)
+{
+	glm::ivec2 first = glm::ivec2(glm::floor((center - halfExtent - origin) * invCellSize));
+	glm::ivec2 last = glm::ivec2(glm::floor((center + halfExtent - origin) * invCellSize));
+	first = glm::max(first, glm::ivec2(0));
+	last = glm::min(last, glm::ivec2(width - 1, height - 1));
+
+	for (int y = first.y; y <= last.y; y++)
+		for (int x = first.x; x <= last.x; x++)
+			blocked[(size_t)y * width + x] = 1;
+	hasGoal = false; //the layout changed; the next update() searches again
+}
+
+void FlowField::update(glm::vec2 goal)
+{
+	glm::ivec2 cell;
+	if (!cellOf(goal, cell)) {
+		hasGoal = false; //goal left the field; nothing inside can route to it
+		return;
+	}
+	if (hasGoal && cell == goalCell)
+		return;
+
+	goalCell = cell;
+	hasGoal = true;
+	search(cell.y * width + cell.x);
+}
+
+void FlowField::search(int goal)
+{
+	searches++;
+	std::fill(distance.begin(), distance.end(), -1);
+
+	//4-connected breadth-first search; the goal cell is searched from even if it is blocked
+	frontier.clear();
+	frontier.push_back(goal);
+	distance[goal] = 0;
+	for (size_t head = 0; head < frontier.size(); head++) {
+		int c = frontier[head];
+		int x = c % width, y = c / width;
+		const int dx[4] = { 1, -1, 0, 0 };
+		const int dy[4] = { 0, 0, 1, -1 };
+		for (int k = 0; k < 4; k++) {
+			int nx = x + dx[k], ny = y + dy[k];
+			if (nx < 0 || ny < 0 || nx >= width || ny >= height)
+				continue;
+			int n = ny * width + nx;
+			if (blocked[n] || distance[n] >= 0)
+				continue;
+			distance[n] = distance[c] + 1;
+			frontier.push_back(n);
+		}
+	}
+
+	//each cell points at its closest neighbour, diagonals included when neither side cell is blocked
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+			int c = y * width + x;
+			glm::vec2& dir = flow[c];
+			dir = glm::vec2(0.0f);
+			if (distance[c] <= 0)
+				continue;
+
+			int best = distance[c];
+			for (int ny = y - 1; ny <= y + 1; ny++) {
+				for (int nx = x - 1; nx <= x + 1; nx++) {
+					if (nx < 0 || ny < 0 || nx >= width || ny >= height || (nx == x && ny == y))
+						continue;
+					int n = ny * width + nx;
+					if (distance[n] < 0 || distance[n] >= best)
+						continue;
+					if (nx != x && ny != y && (blocked[y * width + nx] || blocked[ny * width + x]))
+						continue; //would cut the corner of an obstacle
+					best = distance[n];
+					dir = glm::vec2((float)(nx - x), (float)(ny - y));
+				}
+			}
+			if (dir.x != 0.0f && dir.y != 0.0f)
+				dir *= 0.70710678f;
+		}
+	}
+}
+
+glm::vec2 FlowField::direction(glm::vec2 p) const
+{
+	glm::ivec2 cell;
+	if (!hasGoal || !cellOf(p, cell))
+		return glm::vec2(0.0f);
+	return flow[(size_t)cell.y * width + cell.x];
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "glm\glm.hpp"
+#include <vector>
+#include <cstdint>
+
+/*************************************************
+
+	Grid flow field on the x/y ground plane
+
+	The plane is cut into square cells and the
+	cells covered by obstacles are blocked. A
+	breadth-first search from the goal's cell
+	gives every free cell its distance to the
+	goal, and each cell stores the unit direction
+	toward its closest neighbour. Agents then
+	steer with one lookup instead of a path
+	search each.
+
+	The search only reruns when the goal moves to
+	another cell.
+
+**************************************************/
+
+class FlowField
+{
+	float cellSize;
+	float invCellSize;
+	glm::vec2 origin;			//corner of cell (0, 0)
+	int width = 0, height = 0;
+
+	std::vector<uint8_t> blocked;
+	std::vector<int> distance;		//steps to the goal cell, -1 when unreachable
+	std::vector<glm::vec2> flow;	//unit direction toward the goal, zero in the goal cell and unreachable cells
+	std::vector<int> frontier;		//search queue
+
+	glm::ivec2 goalCell;
+	bool hasGoal = false;
+
+	bool cellOf(glm::vec2 p, glm::ivec2& cell) const;
+	void search(int goal);
+
+public:
+	int searches = 0;	//how many times the field was recomputed
+
+	FlowField(float cell = 1.0f);
+
+	//covers the rectangle [min, max]; clears blocked cells and the goal
+	void setBounds(glm::vec2 min, glm::vec2 max);
+
+	//blocks every cell touched by the square of half-size halfExtent around center
+	void block(glm::vec2 center, float halfExtent);
+
+	//moves the goal; recomputes the field only if the goal changed cells
+	void update(glm::vec2 goal);
+
+	//unit direction to follow from p; zero when p is outside the field, blocked,
+	//cut off from the goal or already in the goal's cell
+	glm::vec2 direction(glm::vec2 p) const;
+};
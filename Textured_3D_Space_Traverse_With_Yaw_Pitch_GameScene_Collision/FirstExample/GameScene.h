@@ -0,0 +1,138 @@
+#pragma once
+#include "GameObject.h"
+#include "SlotMap.h"
+#include "Tank.h"
+#include "Bullet.h"
+#include "Player.h"
+#include "TransformHierarchy.h"
+#include <cassert>
+
+/*************************************************
+
+	Game scene
+
+	One slot map per object type holds every
+	player, tank and bullet by value. Objects are
+	referred to by ObjectHandle: the type tag
+	picks the pool and the index and generation
+	pick the slot, so a handle to an erased object
+	resolves to nullptr instead of dangling.
+
+	Objects marked willBeErased are freed by
+	eraseMarked() at the end of the frame.
+
+	Every tank's body and wheels are nodes of
+	the one scene-wide transform hierarchy; a tank
+	holds only the index of its first node. Call
+	updateTransforms() once a frame after the
+	objects have moved and before they are drawn.
+
+	A forEach() visitor may add objects to the
+	other pools but never to the one being
+	walked: the insert could grow its slot array
+	and move the object being visited. Debug
+	builds assert on it.
+
+**************************************************/
+
+class GameScene
+{
+	ObjectTag walking = TAG_NONE; //the pool forEach() is in, if any
+
+	template <typename T>
+	ObjectHandle insertInto(SlotMap<T>& pool, const T& object, ObjectTag tag)
+	{
+		assert(walking != tag); //would move the object the walk is visiting
+		ObjectHandle handle;
+		handle.type = tag;
+		handle.index = pool.insert(object, handle.generation);
+		pool.get(handle.index, handle.generation)->setHandle(handle);
+		return handle;
+	}
+
+	//gives back whatever the object holds in the scene beyond its slot
+	void detach(Tank& tank) { tank.detachTransforms(transforms); }
+	void detach(GameObject&) {}
+
+	template <typename T>
+	size_t eraseMarkedIn(SlotMap<T>& pool)
+	{
+		size_t erased = 0;
+		for (size_t i = 0; i < pool.capacity(); i++) {
+			T* object = pool.at(i);
+			if (object != nullptr && object->willBeErased) {
+				detach(*object);
+				pool.erase((unsigned int)i);
+				erased++;
+			}
+		}
+		return erased;
+	}
+
+	template <typename T, typename F>
+	void forEachIn(SlotMap<T>& pool, ObjectTag tag, F& visit)
+	{
+		walking = tag;
+		for (size_t i = 0; i < pool.capacity(); i++) {
+			T* object = pool.at(i);
+			if (object != nullptr)
+				visit(static_cast<GameObject*>(object));
+		}
+		walking = TAG_NONE;
+	}
+
+public:
+	SlotMap<Player> players;
+	SlotMap<Tank> tanks;
+	SlotMap<Bullet> bullets;
+	TransformHierarchy transforms;
+
+	ObjectHandle add(const Player& player) { return insertInto(players, player, TAG_PLAYER); }
+	ObjectHandle add(const Tank& tank)
+	{
+		ObjectHandle handle = insertInto(tanks, tank, TAG_TANK);
+		tanks.get(handle.index, handle.generation)->attachTransforms(transforms);
+		return handle;
+	}
+	ObjectHandle add(const Bullet& bullet) { return insertInto(bullets, bullet, TAG_BULLET); }
+
+	//the object the handle refers to, or nullptr if it has been erased
+	GameObject* get(ObjectHandle handle)
+	{
+		switch (handle.type) {
+		case TAG_PLAYER: return players.get(handle.index, handle.generation);
+		case TAG_TANK: return tanks.get(handle.index, handle.generation);
+		case TAG_BULLET: return bullets.get(handle.index, handle.generation);
+		default: return nullptr;
+		}
+	}
+
+	//calls visit(GameObject*) on every live object; players first, then tanks, then bullets, so
+	//bullets a tank fires are visited in the same walk. visit must not add to the pool it is in
+	template <typename F>
+	void forEach(F visit)
+	{
+		forEachIn(players, TAG_PLAYER, visit);
+		forEachIn(tanks, TAG_TANK, visit);
+		forEachIn(bullets, TAG_BULLET, visit);
+	}
+
+	//brings every moved tank's body and wheel matrices up to date
+	void updateTransforms()
+	{
+		transforms.update();
+	}
+
+	//frees every object marked willBeErased; returns how many were freed
+	size_t eraseMarked()
+	{
+		return eraseMarkedIn(players) + eraseMarkedIn(tanks) + eraseMarkedIn(bullets);
+	}
+
+	size_t size() const
+	{
+		return players.size() + tanks.size() + bullets.size();
+	}
+};
+
+extern GameScene gameScene;
@@ -0,0 +1,106 @@
+#include "InstancedBatches.h"
+#include "StreamRing.h"
+#include "TextureArray.h"
+#include <cstring>
+#include <cstddef>
+
+void InstancedBatches::init(GLuint program, StreamRing* ring, const TextureArray* array)
+{
+	stream = ring;
+	textures = array;
+	glGenBuffers(1, &instanceBuffer);
+	instancedLocation = glGetUniformLocation(program, "instanced");
+}
+
+void InstancedBatches::clear()
+{
+	for (size_t b = 0; b < batchesUsed; b++)
+		batches[b].instances.clear();
+	batchesUsed = 0;
+}
+
+void InstancedBatches::add(glm::vec3 position, glm::vec3 scale, GLuint texture)
+{
+	//textures in the array all land in its batch
+	GLint entry = textures ? textures->entryOf(texture) : -1;
+	if (entry >= 0)
+		texture = textures->id();
+
+	//a scene only has a handful of textures, so a linear search beats any map
+	size_t b = 0;
+	while (b < batchesUsed && batches[b].texture != texture)
+		b++;
+	if (b == batchesUsed) {
+		if (batchesUsed == batches.size())
+			batches.push_back(Batch());
+		batches[b].texture = texture;
+		batches[b].layered = entry >= 0;
+		batchesUsed++;
+	}
+	batches[b].instances.push_back(MeshInstance{ position, scale, entry });
+}
+
+void InstancedBatches::draw(GLenum mode, GLint first, GLsizei count)
+{
+	size_t total = 0;
+	for (size_t b = 0; b < batchesUsed; b++)
+		total += batches[b].instances.size();
+	lastInstances = total;
+	lastDrawCalls = 0;
+	if (total == 0)
+		return;
+
+	//write the batches straight into this frame's part of the mapped ring; when there is no ring,
+	//or it is full, orphan last frame's storage instead of waiting for the GPU to finish reading it
+	GLintptr base = 0;
+	MeshInstance* mapped = stream ? (MeshInstance*)stream->allocate(total * sizeof(MeshInstance), 16, base) : nullptr;
+	if (mapped) {
+		for (size_t b = 0; b < batchesUsed; b++) {
+			size_t n = batches[b].instances.size();
+			memcpy(mapped, batches[b].instances.data(), n * sizeof(MeshInstance));
+			mapped += n;
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, stream->id());
+	}
+	else {
+		upload.clear();
+		for (size_t b = 0; b < batchesUsed; b++)
+			upload.insert(upload.end(), batches[b].instances.begin(), batches[b].instances.end());
+		glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+		glBufferData(GL_ARRAY_BUFFER, total * sizeof(MeshInstance), NULL, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, total * sizeof(MeshInstance), upload.data());
+		orphanedFrames++;
+	}
+
+	glEnableVertexAttribArray(positionAttribute);
+	glEnableVertexAttribArray(scaleAttribute);
+	glEnableVertexAttribArray(entryAttribute);
+	glVertexAttribDivisor(positionAttribute, 1);
+	glVertexAttribDivisor(scaleAttribute, 1);
+	glVertexAttribDivisor(entryAttribute, 1);
+	glUniform1i(instancedLocation, 1);
+
+	//each batch points the instance attributes at its own part of the buffer
+	size_t offset = (size_t)base;
+	for (size_t b = 0; b < batchesUsed; b++) {
+		size_t n = batches[b].instances.size();
+		glVertexAttribPointer(positionAttribute, 3, GL_FLOAT, GL_FALSE, sizeof(MeshInstance), BUFFER_OFFSET(offset));
+		glVertexAttribPointer(scaleAttribute, 3, GL_FLOAT, GL_FALSE, sizeof(MeshInstance), BUFFER_OFFSET(offset + offsetof(MeshInstance, scale)));
+		glVertexAttribIPointer(entryAttribute, 1, GL_INT, sizeof(MeshInstance), BUFFER_OFFSET(offset + offsetof(MeshInstance, entry)));
+		if (batches[b].layered) {
+			glActiveTexture(GL_TEXTURE0 + TextureArray::textureUnit);
+			glBindTexture(GL_TEXTURE_2D_ARRAY, batches[b].texture);
+			glActiveTexture(GL_TEXTURE0);
+		}
+		else
+			glBindTexture(GL_TEXTURE_2D, batches[b].texture);
+		glDrawArraysInstanced(mode, first, count, (GLsizei)n);
+		offset += n * sizeof(MeshInstance);
+		lastDrawCalls++;
+	}
+
+	glUniform1i(instancedLocation, 0);
+	glDisableVertexAttribArray(positionAttribute);
+	glDisableVertexAttribArray(scaleAttribute);
+	glDisableVertexAttribArray(entryAttribute);
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "vgl.h"
+#include "glm\glm.hpp"
+#include <vector>
+
+class StreamRing;
+class TextureArray;
+
+/*************************************************
+
+	Instanced batches
+
+	Collects every copy of one mesh drawn in a
+	frame (the cubes, or the enemy pyramids),
+	groups them by texture and draws each group
+	with one glDrawArraysInstanced call, so the
+	number of draw calls follows the number of
+	textures instead of the number of objects.
+
+	Each instance is a position and a per-axis
+	scale, read by triangles.vert from attributes
+	2 and 3 in place of model_matrix. All
+	instances of a frame are written in one go,
+	into the persistently mapped StreamRing when
+	there is one, else into an orphaned buffer.
+
+	With a TextureArray, every texture in it
+	shares one batch: instances carry their
+	entry (attribute 4) and the whole mesh is a
+	single draw call with a single bind.
+
+**************************************************/
+
+struct MeshInstance
+{
+	glm::vec3 position;
+	glm::vec3 scale;
+	GLint entry;			//TextureArray entry, -1 for the batch's own 2D texture
+};
+
+class InstancedBatches
+{
+	struct Batch {
+		GLuint texture;			//the texture array's name for its shared batch
+		bool layered;
+		std::vector<MeshInstance> instances;
+	};
+
+	GLuint instanceBuffer = 0;
+	GLint instancedLocation = -1;		//the "instanced" switch in triangles.vert
+	std::vector<Batch> batches;			//one per texture seen this frame; kept between frames to reuse their memory
+	size_t batchesUsed = 0;
+	std::vector<MeshInstance> upload;	//the batches back to back, when there is no ring to write them to
+	StreamRing* stream = nullptr;
+	const TextureArray* textures = nullptr;
+	size_t lastInstances = 0;
+	int lastDrawCalls = 0;
+
+public:
+	static const GLuint positionAttribute = 2;
+	static const GLuint scaleAttribute = 3;
+	static const GLuint entryAttribute = 4;
+
+	long long orphanedFrames = 0;		//draws that had to fall back to glBufferData
+
+	//creates the fallback instance buffer; needs the linked triangles program. ring and array may be null
+	void init(GLuint program, StreamRing* ring = nullptr, const TextureArray* array = nullptr);
+
+	//starts a new frame
+	void clear();
+
+	void add(glm::vec3 position, glm::vec3 scale, GLuint texture);
+
+	//uploads the frame's instances and draws vertices [first, first + count) of the
+	//bound vertex arrays once per texture; the instance attributes are set on the bound VAO
+	void draw(GLenum mode, GLint first, GLsizei count);
+
+	int drawCalls() const { return lastDrawCalls; }
+	size_t instanceCount() const { return lastInstances; }
+};
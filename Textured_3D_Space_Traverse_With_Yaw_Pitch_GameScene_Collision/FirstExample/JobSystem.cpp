@@ -0,0 +1,128 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+JobSystem::~JobSystem()
+{
+	stop();
+}
+
+void JobSystem::stop()
+{
+	{
+		std::lock_guard<std::mutex> guard(wakeLock);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& t : threads)
+		t.join();
+	threads.clear();
+
+	//the workers are gone, so nothing reads these any more
+	stopping = false;
+	numWorkers = 1;
+	workers.reset();
+}
+
+void JobSystem::start(unsigned count)
+{
+	stop();
+	if (count == 0)
+		count = std::max(1u, std::thread::hardware_concurrency());
+
+	numWorkers = count;
+	workers.reset(new Worker[numWorkers]);
+	for (unsigned i = 1; i < numWorkers; i++)
+		threads.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, const RangeJob& job)
+{
+	grain = std::max<size_t>(grain, 1);
+	size_t chunks = (count + grain - 1) / grain;
+
+	//not worth waking anybody up; run the chunks in order on this thread
+	if (numWorkers <= 1 || chunks <= 1) {
+		for (size_t c = 0; c < chunks; c++)
+			job(c * grain, std::min(count, (c + 1) * grain), 0);
+		return;
+	}
+
+	currentJob = &job;
+	currentCount = count;
+	currentGrain = grain;
+	remaining.store(chunks, std::memory_order_release);
+
+	//deal out contiguous runs of chunks so each worker starts on neighbouring memory
+	for (unsigned w = 0; w < numWorkers; w++) {
+		std::lock_guard<std::mutex> guard(workers[w].lock);
+		for (size_t c = chunks * w / numWorkers; c < chunks * (w + 1) / numWorkers; c++)
+			workers[w].chunks.push_back(c);
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(wakeLock);
+		generation++;
+	}
+	wake.notify_all();
+
+	while (remaining.load(std::memory_order_acquire) > 0) {
+		if (!runOneChunk(0))
+			std::this_thread::yield();
+	}
+}
+
+void JobSystem::workerLoop(unsigned index)
+{
+	unsigned long long seen = 0;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> guard(wakeLock);
+			wake.wait(guard, [&] { return stopping || generation != seen; });
+			if (stopping)
+				return;
+			seen = generation;
+		}
+
+		while (remaining.load(std::memory_order_acquire) > 0) {
+			if (!runOneChunk(index))
+				std::this_thread::yield();
+		}
+	}
+}
+
+bool JobSystem::runOneChunk(unsigned index)
+{
+	size_t chunk;
+	if (!popOwn(index, chunk) && !steal(index, chunk))
+		return false;
+
+	size_t begin = chunk * currentGrain;
+	(*currentJob)(begin, std::min(currentCount, begin + currentGrain), index);
+	remaining.fetch_sub(1, std::memory_order_acq_rel);
+	return true;
+}
+
+bool JobSystem::popOwn(unsigned index, size_t& chunk)
+{
+	Worker& w = workers[index];
+	std::lock_guard<std::mutex> guard(w.lock);
+	if (w.chunks.empty())
+		return false;
+	chunk = w.chunks.back();
+	w.chunks.pop_back();
+	return true;
+}
+
+bool JobSystem::steal(unsigned thief, size_t& chunk)
+{
+	for (unsigned k = 1; k < numWorkers; k++) {
+		Worker& victim = workers[(thief + k) % numWorkers];
+		std::lock_guard<std::mutex> guard(victim.lock);
+		if (!victim.chunks.empty()) {
+			chunk = victim.chunks.front();
+			victim.chunks.pop_front();
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+/*************************************************
+
+	Work-stealing thread pool
+
+	parallelFor() cuts a range into fixed-size
+	chunks and deals them out to per-worker queues.
+	Each worker drains its own queue from the back
+	and steals from the front of the others when
+	it runs dry. The calling thread works as
+	worker 0, so a pool of N workers starts N - 1
+	threads.
+
+	Chunk k always covers [k * grain, (k + 1) * grain),
+	whichever worker runs it, so callers can keep
+	per-chunk output buffers and merge them in
+	chunk order for deterministic results.
+
+**************************************************/
+
+class JobSystem
+{
+public:
+	typedef std::function<void(size_t begin, size_t end, unsigned worker)> RangeJob;
+
+	JobSystem() {}
+	~JobSystem();
+
+	//starts the worker threads; 0 uses every hardware thread, 1 runs everything on the caller.
+	//Starting again stops the running pool first
+	void start(unsigned workers);
+
+	//joins the worker threads; parallelFor then runs everything on the caller until the next start()
+	void stop();
+
+	unsigned workerCount() const { return numWorkers; }
+
+	//runs job over [0, count) in chunks of grain elements and returns once every chunk has finished
+	void parallelFor(size_t count, size_t grain, const RangeJob& job);
+
+private:
+	struct Worker {
+		std::mutex lock;
+		std::deque<size_t> chunks; //chunk indices waiting to run
+	};
+
+	unsigned numWorkers = 1;
+	std::unique_ptr<Worker[]> workers;
+	std::vector<std::thread> threads;
+
+	std::mutex wakeLock;
+	std::condition_variable wake;
+	unsigned long long generation = 0; //bumped for every parallelFor so sleeping workers know there is work
+	bool stopping = false;
+
+	const RangeJob* currentJob = nullptr;
+	size_t currentCount = 0;
+	size_t currentGrain = 1;
+	std::atomic<size_t> remaining{ 0 }; //chunks of the current job not finished yet
+
+	void workerLoop(unsigned index);
+	bool runOneChunk(unsigned index);
+	bool popOwn(unsigned index, size_t& chunk);
+	bool steal(unsigned thief, size_t& chunk);
+};
@@ -3,9 +3,9 @@
 #pragma once
 #include "vgl.h"
 #include "glm\glm.hpp"
+#include "Meshes.h"
 #include <iostream>
 using namespace std;
-extern GLuint Buffers[2];
 
 class Level {
 
@@ -15,21 +15,25 @@ class Level {
 public:
 	Level() = delete;
 
+	//uploads the ground and skybox mesh once; call at startup, after the GL context exists
+	static void initMesh()
+	{
+		Meshes::add(MeshID::levelMesh, GL_QUADS, vertices, textureCoordinates, 28);
+	}
+
 	static void draw()
 	{
 		glm::mat4 model_view = glm::mat4(1);
 		glUniformMatrix4fv(location, 1, GL_FALSE, &model_view[0][0]);
 
-		glBindBuffer(GL_ARRAY_BUFFER, Buffers[0]);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-		glBindBuffer(GL_ARRAY_BUFFER, Buffers[1]);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(textureCoordinates), textureCoordinates, GL_STATIC_DRAW);
+		Meshes::get(MeshID::levelMesh).bind();
 
 		glBindTexture(GL_TEXTURE_2D, Texture::get(TextureID::skybox)); //drawing skybox
 		glDrawArrays(GL_QUADS, 4, 24);
 
 		glBindTexture(GL_TEXTURE_2D, Texture::get(TextureID::grass)); //drawing ground
 		glDrawArrays(GL_QUADS, 0, 4);
+		glBindVertexArray(0);
 	}
 };
 
@@ -0,0 +1,160 @@
+#include "Logger.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdarg>
+
+Logger gameLog;
+
+static const char* typeNames[LOG_TYPE_COUNT] = { "info", "bullet hit enemy", "enemy bullet hit player", "enemy hit player", "game result" };
+
+static long long nowMs()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Logger::Logger() : ring(new Slot[capacity])
+{
+	for (size_t i = 0; i < capacity; i++)
+		ring[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+Logger::~Logger()
+{
+	stop();
+}
+
+void Logger::start()
+{
+	if (running.exchange(true))
+		return;
+	writer = std::thread(&Logger::writerLoop, this);
+}
+
+void Logger::stop()
+{
+	if (!running.exchange(false))
+		return;
+	writer.join();
+	while (writeOne()) {} //anything published after the writer's last pass
+	fflush(stdout);
+}
+
+void Logger::setRateLimit(int type, int perSecond)
+{
+	limits[type].perSecond.store(perSecond, std::memory_order_relaxed);
+}
+
+//decides whether a line of this type goes out; the first line of a new second reports what the last one held back
+bool Logger::admit(int type)
+{
+	RateLimit& limit = limits[type];
+	int perSecond = limit.perSecond.load(std::memory_order_relaxed);
+	if (perSecond <= 0)
+		return true;
+
+	long long now = nowMs();
+	long long start = limit.windowStart.load(std::memory_order_relaxed);
+	if (now - start >= 1000 && limit.windowStart.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+		limit.sent.store(0, std::memory_order_relaxed);
+		int held = limit.suppressed.exchange(0, std::memory_order_relaxed);
+		if (held > 0) {
+			char summary[lineLength];
+			snprintf(summary, sizeof(summary), "(%d more '%s' lines suppressed)", held, typeNames[type]);
+			push(type, summary);
+		}
+	}
+
+	if (limit.sent.fetch_add(1, std::memory_order_relaxed) < perSecond)
+		return true;
+	limit.suppressed.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+void Logger::log(int type, const char* format, ...)
+{
+	if (!admit(type))
+		return;
+
+	char text[lineLength];
+	va_list args;
+	va_start(args, format);
+	vsnprintf(text, sizeof(text), format, args);
+	va_end(args);
+	push(type, text);
+}
+
+//claims the next free slot; a slot is free for position pos when its sequence equals pos
+void Logger::push(int type, const char* text)
+{
+	size_t pos = enqueuePos.load(std::memory_order_relaxed);
+	Slot* slot;
+	for (;;) {
+		slot = &ring[pos & (capacity - 1)];
+		size_t sequence = slot->sequence.load(std::memory_order_acquire);
+		std::ptrdiff_t diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)pos;
+		if (diff == 0) {
+			if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (diff < 0) { //the writer is a whole ring behind
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		else
+			pos = enqueuePos.load(std::memory_order_relaxed);
+	}
+
+	slot->type = type;
+	snprintf(slot->text, lineLength, "%s", text);
+	slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+//writes the oldest published line, if there is one
+bool Logger::writeOne()
+{
+	Slot& slot = ring[dequeuePos & (capacity - 1)];
+	if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1)
+		return false;
+
+	fputs(slot.text, stdout);
+	fputc('\n', stdout);
+	slot.sequence.store(dequeuePos + capacity, std::memory_order_release);
+	dequeuePos++;
+	return true;
+}
+
+void Logger::writerLoop()
+{
+	size_t reportedDrops = 0;
+	while (running.load(std::memory_order_acquire)) {
+		size_t batch = 0;
+		while (writeOne())
+			batch++;
+
+		size_t drops = dropped.load(std::memory_order_relaxed);
+		if (drops != reportedDrops) {
+			printf("(log full, %zu lines dropped)\n", drops - reportedDrops);
+			reportedDrops = drops;
+		}
+
+		if (batch > 0) {
+			fflush(stdout);
+			written.store(dequeuePos, std::memory_order_release);
+		}
+		else
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	written.store(dequeuePos, std::memory_order_release);
+}
+
+void Logger::flush()
+{
+	size_t target = enqueuePos.load(std::memory_order_acquire);
+	if (!running.load(std::memory_order_acquire)) {
+		while (writeOne()) {}
+		fflush(stdout);
+		return;
+	}
+	while (written.load(std::memory_order_acquire) < target)
+		std::this_thread::yield();
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <cstddef>
+
+/*************************************************
+
+	Asynchronous log sink
+
+	log() formats the line into a slot of a fixed
+	ring buffer and returns; a background thread
+	drains the ring and does the actual writing.
+	Any number of threads may log at once without
+	taking a lock. When the ring is full the line
+	is dropped and counted instead of waiting.
+
+	Each message type can be rate limited to a
+	number of lines per second; the surplus is
+	summed up in one line when the next second
+	starts.
+
+**************************************************/
+
+enum Log_Type {
+	LOG_INFO,
+	LOG_BULLET_HIT_ENEMY,
+	LOG_ENEMY_BULLET_HIT_PLAYER,
+	LOG_ENEMY_HIT_PLAYER,
+	LOG_GAME_RESULT,
+	LOG_TYPE_COUNT
+};
+
+class Logger
+{
+	static const size_t capacity = 4096;	//power of two
+	static const size_t lineLength = 120;
+
+	struct Slot {
+		std::atomic<size_t> sequence;	//tells producers and the writer whose turn the slot is
+		int type;
+		char text[lineLength];
+	};
+
+	struct RateLimit {
+		std::atomic<int> perSecond{ 0 };		//0 = unlimited
+		std::atomic<long long> windowStart{ 0 };	//ms
+		std::atomic<int> sent{ 0 };
+		std::atomic<int> suppressed{ 0 };
+	};
+
+	std::unique_ptr<Slot[]> ring;
+	std::atomic<size_t> enqueuePos{ 0 };
+	std::atomic<size_t> written{ 0 };	//lines the writer has finished with
+	std::atomic<size_t> dropped{ 0 };
+	size_t dequeuePos = 0;				//writer thread only
+
+	RateLimit limits[LOG_TYPE_COUNT];
+
+	std::thread writer;
+	std::atomic<bool> running{ false };
+
+	bool admit(int type);
+	void push(int type, const char* text);
+	bool writeOne();
+	void writerLoop();
+
+public:
+	Logger();
+	~Logger();
+
+	//starts the writer thread; lines logged before this wait in the ring
+	void start();
+
+	//writes everything still queued and stops the writer thread
+	void stop();
+
+	//printf-style; never blocks
+	void log(int type, const char* format, ...);
+
+	//caps a message type at this many lines per second (0 = unlimited)
+	void setRateLimit(int type, int perSecond);
+
+	//waits until every line logged so far has been written
+	void flush();
+};
+
+extern Logger gameLog;
@@ -0,0 +1,143 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+bool MappedFile::openRead(const char* path)
+{
+	close();
+	HANDLE f = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (f == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(f, &size) || size.QuadPart == 0 || (unsigned long long)size.QuadPart > (size_t)-1) {
+		CloseHandle(f);
+		return false;
+	}
+	HANDLE m = CreateFileMappingA(f, NULL, PAGE_READONLY, 0, 0, NULL);
+	void* v = m != NULL ? MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0) : NULL;
+	if (v == NULL) {
+		if (m != NULL)
+			CloseHandle(m);
+		CloseHandle(f);
+		return false;
+	}
+	file = f;
+	mapping = m;
+	view = (unsigned char*)v;
+	length = (size_t)size.QuadPart;
+	writable = false;
+	return true;
+}
+
+bool MappedFile::createWrite(const char* path, size_t size)
+{
+	close();
+	if (size == 0)
+		return false;
+	HANDLE f = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (f == INVALID_HANDLE_VALUE)
+		return false;
+	unsigned long long size64 = size;
+	HANDLE m = CreateFileMappingA(f, NULL, PAGE_READWRITE, (DWORD)(size64 >> 32), (DWORD)(size64 & 0xffffffff), NULL);
+	void* v = m != NULL ? MapViewOfFile(m, FILE_MAP_WRITE, 0, 0, size) : NULL;
+	if (v == NULL) {
+		if (m != NULL)
+			CloseHandle(m);
+		CloseHandle(f);
+		return false;
+	}
+	file = f;
+	mapping = m;
+	view = (unsigned char*)v;
+	length = size;
+	writable = true;
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (view != nullptr) {
+		if (writable)
+			FlushViewOfFile(view, 0);
+		UnmapViewOfFile(view);
+	}
+	if (mapping != nullptr)
+		CloseHandle((HANDLE)mapping);
+	if (file != nullptr)
+		CloseHandle((HANDLE)file);
+	view = nullptr;
+	mapping = nullptr;
+	file = nullptr;
+	length = 0;
+}
+
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+bool MappedFile::openRead(const char* path)
+{
+	close();
+	int f = ::open(path, O_RDONLY);
+	if (f < 0)
+		return false;
+	struct stat info;
+	if (fstat(f, &info) != 0 || info.st_size == 0) {
+		::close(f);
+		return false;
+	}
+	void* v = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, f, 0);
+	if (v == MAP_FAILED) {
+		::close(f);
+		return false;
+	}
+	fd = f;
+	view = (unsigned char*)v;
+	length = (size_t)info.st_size;
+	writable = false;
+	return true;
+}
+
+bool MappedFile::createWrite(const char* path, size_t size)
+{
+	close();
+	if (size == 0)
+		return false;
+	int f = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (f < 0)
+		return false;
+	if (ftruncate(f, (off_t)size) != 0) {
+		::close(f);
+		return false;
+	}
+	void* v = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, f, 0);
+	if (v == MAP_FAILED) {
+		::close(f);
+		return false;
+	}
+	fd = f;
+	view = (unsigned char*)v;
+	length = size;
+	writable = true;
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (view != nullptr) {
+		if (writable)
+			msync(view, length, MS_SYNC);
+		munmap(view, length);
+	}
+	if (fd >= 0)
+		::close(fd);
+	view = nullptr;
+	fd = -1;
+	length = 0;
+}
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+
+/*************************************************
+
+	Memory-mapped file
+
+	Maps a whole file into the address space, so
+	it can be read or filled in place with plain
+	memory copies. Uses CreateFileMapping on
+	Windows and mmap elsewhere.
+
+**************************************************/
+
+class MappedFile
+{
+	unsigned char* view = nullptr;
+	size_t length = 0;
+	bool writable = false;
+#ifdef _WIN32
+	void* file = nullptr;		//HANDLE
+	void* mapping = nullptr;	//HANDLE
+#else
+	int fd = -1;
+#endif
+
+public:
+	MappedFile() {}
+	~MappedFile() { close(); }
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	//maps an existing file read-only; false if it cannot be opened or is empty
+	bool openRead(const char* path);
+
+	//creates or truncates the file to size bytes and maps it for writing
+	bool createWrite(const char* path, size_t size);
+
+	//unmaps; a writable view is flushed to the file first
+	void close();
+
+	unsigned char* data() { return view; }
+	const unsigned char* data() const { return view; }
+	size_t size() const { return length; }
+};
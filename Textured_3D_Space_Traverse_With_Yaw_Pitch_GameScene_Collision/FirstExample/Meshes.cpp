@@ -0,0 +1,5 @@
+#include "Meshes.h"
+
+//initialization of static members
+
+StaticMesh Meshes::meshes[Meshes::numMeshes]{};
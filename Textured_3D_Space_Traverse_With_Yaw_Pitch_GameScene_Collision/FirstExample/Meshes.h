@@ -0,0 +1,33 @@
+#pragma once
+#include "vgl.h"
+#include "StaticMesh.h"
+
+//enum representing mesh indexes
+enum MeshID {
+	levelMesh,
+	tankMesh,
+	wheelMesh,
+	bulletMesh
+};
+
+//helper class that holds every static mesh; NOT a wrapper class for meshes (should not be instantiated)
+//each mesh is uploaded once by its owner's initMesh() at startup, draws only bind it
+class Meshes
+{
+public:
+	static const int numMeshes = 4; //total number of meshes
+
+private:
+	static StaticMesh meshes[numMeshes];
+
+public:
+	Meshes() = delete; //cannot be instantiated
+
+	//uploads a mesh from separate vertex and texture coordinate arrays
+	static void add(MeshID id, GLenum primitive, const GLfloat (*vertices)[3], const GLfloat (*texCoords)[2], GLsizei count)
+	{
+		meshes[id].upload(primitive, vertices, texCoords, count);
+	}
+
+	static inline const StaticMesh& get(MeshID id) { return meshes[id]; } //gets a mesh at the index
+};
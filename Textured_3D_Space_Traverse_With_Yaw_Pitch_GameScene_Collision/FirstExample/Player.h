@@ -18,6 +18,7 @@
 #include "camera.h"
 #include "Tank.h"
 #include "Bullet.h"
+#include "CollisionDispatch.h"
 
 extern int gs;
 
@@ -28,6 +29,7 @@ class Player : public GameObject
 public:
 	Player() : GameObject(cam::cam_pos, cam::looking_dir_vector) {
 		setDimensions(0.1, 0.1, 0.4);
+		setTag(TAG_PLAYER);
 	};
 
 	void incTanksShot() { tanksShot++; }
@@ -44,17 +46,7 @@ public:
 
 	//collision detection
 	virtual void checkCollision(GameObject* obj) {
-		
-		if (auto bullet = dynamic_cast<Bullet*>(obj))
-		{
-			if (isColliding(bullet))
-			{
-				if (bullet->getSource() != nullptr)
-					if (auto tank = dynamic_cast<Tank*>(bullet->getSource()))
-						gs = 2; //defeat
-			}
-		}
-	
+		respondToCollision(this, obj); //response is looked up by the (player, obj) tag pair; see CollisionDispatch.cpp
 	};
 
 	virtual void idle() {
@@ -0,0 +1,108 @@
+#include "Replay.h"
+#include "World.h"
+#include <fstream>
+#include <iostream>
+#include <cstring>
+
+const char replayMagic[8] = { 'W', '3', 'D', 'R', 'P', 'L', 'Y', 0 };
+const uint32_t replayVersion = 1;
+
+struct ReplayHeader
+{
+	char magic[8];
+	uint32_t version;
+	int32_t ticks;
+	uint64_t seed;
+	uint64_t checksum;
+	uint64_t inputCount;
+};
+static_assert(sizeof(ReplayHeader) == 40, "replay header layout changed");
+
+void Replay::addKey(int tick, unsigned char key, float frameMs)
+{
+	ReplayInput input = {};
+	input.tick = tick;
+	input.key = key;
+	input.frameMs = frameMs;
+	inputs.push_back(input);
+}
+
+void Replay::addMouse(int tick, int x, int y)
+{
+	ReplayInput input = {};
+	input.tick = tick;
+	input.isMouse = 1;
+	input.x = x;
+	input.y = y;
+	inputs.push_back(input);
+}
+
+void Replay::apply(World& w, int tick, size_t& next) const
+{
+	while (next < inputs.size() && inputs[next].tick < tick) {
+		const ReplayInput& input = inputs[next++];
+		if (input.isMouse)
+			w.mouse(input.x, input.y);
+		else
+			w.keyboard(input.key, input.frameMs);
+	}
+}
+
+bool Replay::save(const std::string& path) const
+{
+	std::ofstream file(path, std::ios::binary);
+	if (!file) {
+		std::cout << "Failed to create replay " << path << std::endl;
+		return false;
+	}
+
+	ReplayHeader header = {};
+	std::memcpy(header.magic, replayMagic, sizeof(header.magic));
+	header.version = replayVersion;
+	header.ticks = ticks;
+	header.seed = seed;
+	header.checksum = checksum;
+	header.inputCount = inputs.size();
+	file.write((const char*)&header, sizeof(header));
+	if (!inputs.empty())
+		file.write((const char*)inputs.data(), inputs.size() * sizeof(ReplayInput));
+	if (!file) {
+		std::cout << "Failed to write replay " << path << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool Replay::load(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		std::cout << "Failed to open replay " << path << std::endl;
+		return false;
+	}
+
+	ReplayHeader header;
+	if (!file.read((char*)&header, sizeof(header)) || std::memcmp(header.magic, replayMagic, sizeof(header.magic)) != 0) {
+		std::cout << path << ": not a replay" << std::endl;
+		return false;
+	}
+	if (header.version != replayVersion) {
+		std::cout << path << ": replay version " << header.version << ", expected " << replayVersion << std::endl;
+		return false;
+	}
+
+	std::vector<ReplayInput> loaded;
+	ReplayInput input;
+	while (loaded.size() < header.inputCount && file.read((char*)&input, sizeof(input)))
+		loaded.push_back(input);
+	if (loaded.size() != header.inputCount) {
+		std::cout << path << ": replay is truncated" << std::endl;
+		return false;
+	}
+
+	seed = header.seed;
+	ticks = header.ticks;
+	checksum = header.checksum;
+	inputs.swap(loaded);
+	return true;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+
+class World;
+
+/*************************************************
+
+	Input replay
+
+	Everything that makes two windowed runs differ
+	is the random seed and the player's input, so
+	a recording is just those: the seed and every
+	key press and mouse move, stamped with the
+	simulation tick it arrived before and the frame
+	time movement keys were scaled by.
+
+	Played back against a world seeded the same
+	way, the match takes exactly the same course
+	at any speed; the checksum taken when the
+	recording ended proves it.
+
+	Stored as a small binary file: a fixed header
+	followed by the raw input records.
+
+**************************************************/
+
+struct ReplayInput
+{
+	int32_t tick;		//ticks completed when the input arrived; applied before tick + 1
+	uint8_t isMouse;
+	uint8_t key;
+	uint16_t reserved;
+	int32_t x, y;
+	float frameMs;		//what keyboard() scaled camera movement by
+};
+static_assert(sizeof(ReplayInput) == 20, "replay input layout changed");
+
+struct Replay
+{
+	uint64_t seed = 1;
+	int ticks = 0;				//length of the recording in ticks
+	uint64_t checksum = 0;		//World::checksum() after the last tick
+	std::vector<ReplayInput> inputs; //in the order they arrived
+
+	void addKey(int tick, unsigned char key, float frameMs);
+	void addMouse(int tick, int x, int y);
+
+	//feeds the world every input recorded before this tick; next carries over between ticks
+	void apply(World& w, int tick, size_t& next) const;
+
+	//both print the problem and return false on failure
+	bool save(const std::string& path) const;
+	bool load(const std::string& path);
+};
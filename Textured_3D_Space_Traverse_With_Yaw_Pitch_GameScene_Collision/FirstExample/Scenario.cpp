@@ -0,0 +1,76 @@
+#include "Scenario.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+bool Scenario::load(const std::string& path)
+{
+	std::ifstream file(path);
+	if (!file) {
+		std::cout << "Failed to open scenario " << path << std::endl;
+		return false;
+	}
+
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(file, line)) {
+		lineNumber++;
+		line = line.substr(0, line.find('#')); //strip comments
+
+		std::istringstream in(line);
+		std::string name;
+		if (!(in >> name))
+			continue; //blank line
+
+		bool ok;
+		if (name == "ticks") ok = (bool)(in >> ticks);
+		else if (name == "enemies") ok = (bool)(in >> enemies);
+		else if (name == "bullets") ok = (bool)(in >> bullets);
+		else if (name == "arena") ok = (bool)(in >> arena);
+		else if (name == "obstacles") ok = (bool)(in >> obstacles);
+		else if (name == "obstacle_area") ok = (bool)(in >> obstacleArea);
+		else if (name == "spawn_interval") ok = (bool)(in >> spawnInterval);
+		else if (name == "health") ok = (bool)(in >> health);
+		else if (name == "win_time") ok = (bool)(in >> winTime) && winTime >= 0;
+		else if (name == "seed") ok = (bool)(in >> seed);
+		else if (name == "report_every") ok = (bool)(in >> reportEvery);
+		else if (name == "size_report_every") ok = (bool)(in >> sizeReportEvery) && sizeReportEvery >= 0;
+		else if (name == "threads") ok = (bool)(in >> threads);
+		else if (name == "log_limit") ok = (bool)(in >> logLimit);
+		else if (name == "key") {
+			ScriptedInput input{};
+			ok = (bool)(in >> input.tick >> input.key);
+			inputs.push_back(input);
+		}
+		else if (name == "lod_band") {
+			ScenarioBand band{};
+			ok = (bool)(in >> band.minDistance >> band.interval) && band.minDistance >= 0 && band.interval >= 1;
+			lodBands.push_back(band);
+		}
+		else if (name == "mouse") {
+			ScriptedInput input{};
+			input.isMouse = true;
+			ok = (bool)(in >> input.tick >> input.x >> input.y);
+			inputs.push_back(input);
+		}
+		else if (name == "save_snapshot") ok = (bool)(in >> saveSnapshotTick >> saveSnapshotPath) && saveSnapshotTick >= 1;
+		else if (name == "load_snapshot") ok = (bool)(in >> loadSnapshotPath);
+		else {
+			std::cout << path << ":" << lineNumber << ": unknown setting '" << name << "'" << std::endl;
+			return false;
+		}
+
+		if (!ok) {
+			std::cout << path << ":" << lineNumber << ": bad value for '" << name << "'" << std::endl;
+			return false;
+		}
+	}
+
+	std::stable_sort(inputs.begin(), inputs.end(), [](const ScriptedInput& a, const ScriptedInput& b) { return a.tick < b.tick; });
+	std::stable_sort(lodBands.begin(), lodBands.end(), [](const ScenarioBand& a, const ScenarioBand& b) { return a.minDistance < b.minDistance; });
+	//the first band covers every distance, so closer than the first listed one stays at full rate
+	if (!lodBands.empty() && lodBands[0].minDistance > 0)
+		lodBands.insert(lodBands.begin(), ScenarioBand{ 0.0f, 1 });
+	return true;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <vector>
+#include <string>
+
+/*************************************************
+
+	Headless scenario description
+
+	Plain text, one setting per line, '#' starts
+	a comment:
+
+		ticks 1000			number of simulation ticks to run
+		enemies 100000		enemies placed before the first tick
+		bullets 5000		player bullets placed before the first tick
+		arena 200			half-size of the square the preload spreads over
+		obstacles 20000		number of static obstacles
+		obstacle_area 50	half-size of the square the obstacles are scattered over
+		spawn_interval 500	starting enemy spawn interval (ms)
+		health 100			starting player health
+		win_time 30000		surviving this many simulated ms wins (0 = never)
+		seed 1				random seed; --batch gives world k seed + k
+		report_every 100	print running costs every N ticks (0 = only at the end)
+		size_report_every 6000	print entity counts, slots and capacity every N ticks
+		threads 4			worker threads for the enemy update (0 = every core)
+		lod_band 50 4		enemies at least 50 units away update every 4th tick;
+							listing any band replaces the default ones, and
+							enemies closer than the nearest band update
+							every tick
+		log_limit 20		hit messages per type per second (0 = all of them)
+		key 120 f			press a key at a tick
+		mouse 300 520 500	move the mouse to (x, y) at a tick
+		save_snapshot 250 a.snap	save the whole world to a.snap after a tick
+		load_snapshot a.snap	start from a saved world instead of the
+							settings above; inputs and snapshots before
+							the tick after the saved one are skipped
+
+**************************************************/
+
+struct ScriptedInput
+{
+	int tick;
+	bool isMouse;
+	unsigned char key;
+	int x, y;
+};
+
+struct ScenarioBand
+{
+	float minDistance;
+	int interval;
+};
+
+struct Scenario
+{
+	int ticks = 1000;
+	int enemies = 0;
+	int bullets = 0;
+	float arena = 20.0f;
+	int obstacles = 20;
+	float obstacleArea = 50.0f;
+	float spawnInterval = 3000.0f;
+	int health = 100;
+	int winTime = 30000;
+	unsigned int seed = 1;
+	int reportEvery = 0;
+	int sizeReportEvery = 0;
+	unsigned int threads = 0;
+	int logLimit = 0;
+	std::vector<ScriptedInput> inputs; //sorted by tick
+	std::vector<ScenarioBand> lodBands; //sorted by distance
+	int saveSnapshotTick = 0;
+	std::string saveSnapshotPath; //empty = never save
+	std::string loadSnapshotPath; //empty = build the world from the settings
+
+	//reads a scenario file; prints the problem and returns false on a bad file
+	bool load(const std::string& path);
+};
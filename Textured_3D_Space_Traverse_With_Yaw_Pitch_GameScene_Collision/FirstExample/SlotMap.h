@@ -0,0 +1,98 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+/*************************************************
+
+	Slot map
+
+	Objects of one type live by value in a single
+	array of slots, so adding one costs no heap
+	allocation once the array has grown. A freed
+	slot goes on a free list and is reused by the
+	next insert. Every slot carries a generation
+	that is bumped when its object is freed, and
+	lookups must present the generation they were
+	handed: an index into a slot that has since
+	been freed or reused resolves to nothing.
+
+	Slots move when the array grows, so hold an
+	index and generation across frames, not a
+	pointer.
+
+**************************************************/
+
+template <typename T>
+class SlotMap
+{
+	struct Slot {
+		T object;
+		unsigned int generation;
+		bool alive;
+	};
+
+	std::vector<Slot> slots;
+	std::vector<unsigned int> freeSlots;
+	size_t count = 0;
+
+public:
+	void reserve(size_t n)
+	{
+		slots.reserve(n);
+	}
+
+	//copies object into a free slot; returns the slot index and sets its generation
+	unsigned int insert(const T& object, unsigned int& generation)
+	{
+		unsigned int index;
+		if (!freeSlots.empty()) {
+			index = freeSlots.back();
+			freeSlots.pop_back();
+			slots[index].object = object;
+			slots[index].alive = true;
+		}
+		else {
+			index = (unsigned int)slots.size();
+			slots.push_back(Slot{ object, 0, true });
+		}
+		count++;
+		generation = slots[index].generation;
+		return index;
+	}
+
+	//frees the slot; every index/generation pair handed out for it goes stale
+	void erase(unsigned int index)
+	{
+		if (index >= slots.size() || !slots[index].alive)
+			return;
+		slots[index].alive = false;
+		slots[index].generation++;
+		freeSlots.push_back(index);
+		count--;
+	}
+
+	//the object, or nullptr if the slot was freed since the generation was handed out
+	T* get(unsigned int index, unsigned int generation)
+	{
+		if (index >= slots.size() || !slots[index].alive || slots[index].generation != generation)
+			return nullptr;
+		return &slots[index].object;
+	}
+
+	//number of slots, live or free, for an index-based walk with at(); an insert during the walk
+	//may grow the slots and move every object, so a walk must not insert into the map it walks
+	size_t capacity() const
+	{
+		return slots.size();
+	}
+
+	T* at(size_t index)
+	{
+		return slots[index].alive ? &slots[index].object : nullptr;
+	}
+
+	size_t size() const
+	{
+		return count;
+	}
+};
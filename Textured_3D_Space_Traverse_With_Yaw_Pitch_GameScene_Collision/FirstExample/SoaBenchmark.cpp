@@ -0,0 +1,147 @@
+#include "Benchmarks.h"
+#include "World.h"
+#include <cstdio>
+#include <algorithm>
+#include <cmath>
+
+// The same two passes the simulation runs every tick, once over the array-of-structs layout the
+// game started with and once over the struct-of-arrays EntityStore. Bullets fly straight, enemies
+// home in on a target, then every enemy is tested against the bullets near it through the grid.
+
+static const int soaBenchTicks = 20;
+static const glm::vec3 soaBenchTarget(0.0f, 0.0f, 0.5f);
+
+struct SoaBenchResult {
+    double movementMs = 0;
+    double collisionMs = 0;
+    long long hits = 0;
+    glm::vec3 checksum = glm::vec3(0);  // sum of every final location, to show both layouts did the same work
+};
+
+static void runAos(std::vector<GameObject>& bullets, std::vector<GameObject>& enemies, SoaBenchResult& result) {
+    SpatialGrid grid;
+    std::vector<int> nearby;
+    for (int tick = 0; tick < soaBenchTicks; tick++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (GameObject& b : bullets) {
+            if (b.life_span > 0 && b.isAlive) {
+                b.location += ((GLfloat)simTickMs) * b.velocity * glm::normalize(b.moving_direction);
+                b.living_time += simTickMs;
+            }
+        }
+        for (GameObject& e : enemies) {
+            if (!e.isAlive) continue;
+            e.moving_direction = glm::normalize(soaBenchTarget - e.location);
+            e.location += e.moving_direction * e.velocity * (GLfloat)simTickMs;
+        }
+        result.movementMs += elapsedMs(start);
+
+        start = std::chrono::steady_clock::now();
+        grid.clear();
+        for (size_t i = 0; i < bullets.size(); i++) {
+            if (bullets[i].isAlive)
+                grid.insert((int)i, bullets[i].location, bullets[i].collider_dimension);
+        }
+        grid.build();
+        for (GameObject& e : enemies) {
+            if (!e.isAlive) continue;
+            nearby.clear();
+            grid.query(e.location, e.collider_dimension, nearby);
+            for (int b : nearby) {
+                if (aabbOverlap(bullets[b].location, bullets[b].collider_dimension, e.location, e.collider_dimension)) {
+                    e.isCollided = true;
+                    bullets[b].isCollided = true;
+                    result.hits++;
+                }
+            }
+        }
+        result.collisionMs += elapsedMs(start);
+    }
+    for (const GameObject& b : bullets)
+        result.checksum += b.location;
+    for (const GameObject& e : enemies)
+        result.checksum += e.location;
+}
+
+static void runSoa(EntityStore& bullets, EntityStore& enemies, SoaBenchResult& result) {
+    SpatialGrid grid;
+    std::vector<int> nearby;
+    for (int tick = 0; tick < soaBenchTicks; tick++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < bullets.size(); i++) {
+            if (bullets.life_span[i] > 0 && bullets.isAlive[i]) {
+                bullets.location[i] += ((GLfloat)simTickMs) * bullets.velocity[i] * glm::normalize(bullets.moving_direction[i]);
+                bullets.living_time[i] += simTickMs;
+            }
+        }
+        for (size_t j = 0; j < enemies.size(); j++) {
+            if (!enemies.isAlive[j]) continue;
+            enemies.moving_direction[j] = glm::normalize(soaBenchTarget - enemies.location[j]);
+            enemies.location[j] += enemies.moving_direction[j] * enemies.velocity[j] * (GLfloat)simTickMs;
+        }
+        result.movementMs += elapsedMs(start);
+
+        start = std::chrono::steady_clock::now();
+        grid.clear();
+        for (size_t i = 0; i < bullets.size(); i++) {
+            if (bullets.isAlive[i])
+                grid.insert((int)i, bullets.location[i], bullets.collider_dimension[i]);
+        }
+        grid.build();
+        for (size_t j = 0; j < enemies.size(); j++) {
+            if (!enemies.isAlive[j]) continue;
+            nearby.clear();
+            grid.query(enemies.location[j], enemies.collider_dimension[j], nearby);
+            for (int b : nearby) {
+                if (aabbOverlap(bullets.location[b], bullets.collider_dimension[b], enemies.location[j], enemies.collider_dimension[j])) {
+                    enemies.isCollided[j] = true;
+                    bullets.isCollided[b] = true;
+                    result.hits++;
+                }
+            }
+        }
+        result.collisionMs += elapsedMs(start);
+    }
+    for (size_t i = 0; i < bullets.size(); i++)
+        result.checksum += bullets.location[i];
+    for (size_t j = 0; j < enemies.size(); j++)
+        result.checksum += enemies.location[j];
+}
+
+int runSoaBenchmark(int entities) {
+    entities = std::max(2, entities);
+    const float arena = std::sqrt((float)entities);  // about one entity per 4 square units at any count
+
+    // Half bullets, half enemies, the same objects in both layouts
+    World w;
+    w.rng.seed(1);
+    std::vector<GameObject> aosBullets, aosEnemies;
+    EntityStore soaBullets, soaEnemies;
+    for (int i = 0; i < entities; i++) {
+        glm::vec3 position(w.rng.uniform(-arena, arena), w.rng.uniform(-arena, arena), w.rng.uniform(0.1f, 1.0f));
+        if (i % 2 == 0) {
+            glm::vec3 direction(w.rng.uniform(-1, 1), w.rng.uniform(-1, 1), 0.01f);
+            GameObject bullet = w.makeBullet(position, direction, 0.01f, 0);
+            aosBullets.push_back(bullet);
+            soaBullets.spawn(bullet);
+        }
+        else {
+            GameObject enemy = w.makeEnemy(position);
+            aosEnemies.push_back(enemy);
+            soaEnemies.spawn(enemy);
+        }
+    }
+
+    SoaBenchResult aos, soa;
+    runAos(aosBullets, aosEnemies, aos);
+    runSoa(soaBullets, soaEnemies, soa);
+
+    bool same = aos.hits == soa.hits && aos.checksum == soa.checksum;
+    printf("%d entities (%d bullets, %d enemies), %d ticks, %lld hits%s\n", entities, (int)aosBullets.size(), (int)aosEnemies.size(),
+        soaBenchTicks, soa.hits, same ? "" : " (MISMATCH)");
+    printf("  movement   array of structs %.3f ms/tick, struct of arrays %.3f ms/tick (%.2fx)\n",
+        aos.movementMs / soaBenchTicks, soa.movementMs / soaBenchTicks, aos.movementMs / std::max(soa.movementMs, 1e-9));
+    printf("  collision  array of structs %.3f ms/tick, struct of arrays %.3f ms/tick (%.2fx)\n",
+        aos.collisionMs / soaBenchTicks, soa.collisionMs / soaBenchTicks, aos.collisionMs / std::max(soa.collisionMs, 1e-9));
+    return same ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cell) : cellSize(cell), invCellSize(1.0f / cell)
+{
+}
+
+size_t SpatialGrid::hashCell(int x, int y, int z) const
+{
+	//large primes spread neighbouring cells across the table
+	return (size_t)(((unsigned)x * 73856093u) ^ ((unsigned)y * 19349663u) ^ ((unsigned)z * 83492791u)) & bucketMask;
+}
+
+glm::ivec3 SpatialGrid::toCell(glm::vec3 p) const
+{
+	return glm::ivec3((int)std::floor(p.x * invCellSize), (int)std::floor(p.y * invCellSize), (int)std::floor(p.z * invCellSize));
+}
+
+void SpatialGrid::clear()
+{
+	entries.clear();
+}
+
+void SpatialGrid::insert(int index, glm::vec3 center, float size)
+{
+	//small margin so boxes that exactly touch always end up sharing a cell
+	glm::vec3 half = glm::vec3(size / 2 + cellSize * 0.001f);
+
+	Entry e;
+	e.index = index;
+	e.minCell = toCell(center - half);
+	e.maxCell = toCell(center + half);
+	entries.push_back(e);
+}
+
+void SpatialGrid::build()
+{
+	//count how many cells are covered in total to size the table
+	size_t cellRefs = 0;
+	for (const Entry& e : entries) {
+		glm::ivec3 span = e.maxCell - e.minCell + glm::ivec3(1);
+		cellRefs += (size_t)span.x * span.y * span.z;
+	}
+
+	size_t buckets = 1024;
+	while (buckets < cellRefs * 2)
+		buckets <<= 1;
+	bucketMask = buckets - 1;
+
+	//counting sort of the objects into buckets
+	bucketStart.assign(buckets + 1, 0);
+	for (const Entry& e : entries)
+		for (int x = e.minCell.x; x <= e.maxCell.x; x++)
+			for (int y = e.minCell.y; y <= e.maxCell.y; y++)
+				for (int z = e.minCell.z; z <= e.maxCell.z; z++)
+					bucketStart[hashCell(x, y, z) + 1]++;
+
+	for (size_t b = 0; b < buckets; b++)
+		bucketStart[b + 1] += bucketStart[b];
+
+	bucketObjects.resize(cellRefs);
+	std::vector<int> fill(bucketStart.begin(), bucketStart.end() - 1);
+	for (const Entry& e : entries)
+		for (int x = e.minCell.x; x <= e.maxCell.x; x++)
+			for (int y = e.minCell.y; y <= e.maxCell.y; y++)
+				for (int z = e.minCell.z; z <= e.maxCell.z; z++)
+					bucketObjects[fill[hashCell(x, y, z)]++] = e.index;
+}
+
+void SpatialGrid::query(glm::vec3 center, float size, std::vector<int>& out) const
+{
+	out.clear();
+	if (entries.empty())
+		return;
+
+	glm::vec3 half = glm::vec3(size / 2 + cellSize * 0.001f);
+	glm::ivec3 minCell = toCell(center - half);
+	glm::ivec3 maxCell = toCell(center + half);
+
+	for (int x = minCell.x; x <= maxCell.x; x++)
+		for (int y = minCell.y; y <= maxCell.y; y++)
+			for (int z = minCell.z; z <= maxCell.z; z++) {
+				size_t b = hashCell(x, y, z);
+				for (int k = bucketStart[b]; k < bucketStart[b + 1]; k++)
+					out.push_back(bucketObjects[k]);
+			}
+
+	//objects covering several cells (or hash collisions) show up more than once
+	std::sort(out.begin(), out.end());
+	out.erase(std::unique(out.begin(), out.end()), out.end());
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "glm\glm.hpp"
+#include <vector>
+
+/*************************************************
+
+	Uniform grid broadphase (spatial hash)
+
+	Objects are inserted with their center and
+	collider size, then build() sorts them into
+	hashed cells. query() returns every object
+	that shares a cell with the given box, so the
+	narrowphase only runs on nearby pairs. Queries
+	do not modify the grid.
+
+	The grid is meant to be cleared and rebuilt
+	every frame.
+
+**************************************************/
+
+class SpatialGrid
+{
+	float cellSize;
+	float invCellSize;
+
+	struct Entry {
+		int index;			//index of the object in the caller's container
+		glm::ivec3 minCell;	//first cell covered by the object
+		glm::ivec3 maxCell;	//last cell covered by the object
+	};
+
+	std::vector<Entry> entries;		//objects inserted since the last clear()
+	std::vector<int> bucketStart;	//start of each bucket in bucketObjects (bucket count + 1 entries)
+	std::vector<int> bucketObjects;	//object indices sorted by bucket
+	size_t bucketMask = 0;
+
+	size_t hashCell(int x, int y, int z) const;
+	glm::ivec3 toCell(glm::vec3 p) const;
+
+public:
+	SpatialGrid(float cell = 2.0f);
+
+	void clear();
+
+	//adds an object to the grid; index is what query() will report for it
+	void insert(int index, glm::vec3 center, float size);
+
+	//sorts the inserted objects into their buckets; must be called before query()
+	void build();
+
+	//collects the indices of all objects sharing a cell with the box, in ascending order;
+	//safe to call from several threads at once after build()
+	void query(glm::vec3 center, float size, std::vector<int>& out) const;
+};
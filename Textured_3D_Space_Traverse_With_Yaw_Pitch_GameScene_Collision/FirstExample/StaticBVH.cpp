@@ -0,0 +1,187 @@
+#include "StaticBVH.h"
+#include <algorithm>
+#include <limits>
+
+static const int maxLeafItems = 4;
+
+void StaticBVH::clear()
+{
+	items.clear();
+	nodes.clear();
+}
+
+void StaticBVH::insert(int index, glm::vec3 center, float size)
+{
+	items.push_back(Item{ center, size, index });
+}
+
+void StaticBVH::build()
+{
+	nodes.clear();
+	if (items.empty())
+		return;
+	nodes.reserve(2 * items.size());
+	buildNode(0, (int)items.size());
+}
+
+//splits the items at the median of the longest axis of their centers
+int StaticBVH::buildNode(int first, int count)
+{
+	int self = (int)nodes.size();
+	nodes.push_back(Node());
+
+	glm::vec3 min(std::numeric_limits<float>::max());
+	glm::vec3 max(-std::numeric_limits<float>::max());
+	glm::vec3 centerMin = min, centerMax = max;
+	for (int i = first; i < first + count; i++) {
+		float half = items[i].size / 2;
+		min = glm::min(min, items[i].center - half);
+		max = glm::max(max, items[i].center + half);
+		centerMin = glm::min(centerMin, items[i].center);
+		centerMax = glm::max(centerMax, items[i].center);
+	}
+	//bounds are only used to skip branches; pad them so rounding never skips a touching box
+	glm::vec3 pad = 1e-5f * (glm::vec3(1.0f) + glm::max(glm::abs(min), glm::abs(max)));
+	nodes[self].min = min - pad;
+	nodes[self].max = max + pad;
+
+	if (count <= maxLeafItems) {
+		nodes[self].first = first;
+		nodes[self].count = count;
+		return self;
+	}
+
+	glm::vec3 extent = centerMax - centerMin;
+	int axis = 0;
+	if (extent.y > extent[axis]) axis = 1;
+	if (extent.z > extent[axis]) axis = 2;
+
+	int half = count / 2;
+	std::nth_element(items.begin() + first, items.begin() + first + half, items.begin() + first + count,
+		[axis](const Item& a, const Item& b) {
+			if (a.center[axis] != b.center[axis])
+				return a.center[axis] < b.center[axis];
+			return a.index < b.index; //ties broken by index so the tree does not depend on insertion order
+		});
+
+	buildNode(first, half);
+	int right = buildNode(first + half, count - half);
+	nodes[self].first = right;
+	nodes[self].count = 0;
+	return self;
+}
+
+void StaticBVH::query(glm::vec3 center, float size, std::vector<int>& out) const
+{
+	if (nodes.empty())
+		return;
+
+	float half = size / 2;
+	glm::vec3 min = center - half, max = center + half;
+
+	int stack[64];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		const Node& node = nodes[stack[--top]];
+		if (glm::any(glm::lessThan(max, node.min)) || glm::any(glm::greaterThan(min, node.max)))
+			continue;
+
+		if (node.count > 0) {
+			for (int i = node.first; i < node.first + node.count; i++) {
+				const Item& item = items[i];
+				float reach = size / 2 + item.size / 2;
+				if (glm::abs(center.x - item.center.x) <= reach &&
+					glm::abs(center.y - item.center.y) <= reach &&
+					glm::abs(center.z - item.center.z) <= reach)
+					out.push_back(item.index);
+			}
+		}
+		else {
+			int self = (int)(&node - &nodes[0]);
+			stack[top++] = node.first;
+			stack[top++] = self + 1;
+		}
+	}
+}
+
+void StaticBVH::queryBatch(const std::vector<int>& queries, const glm::vec3* centers, const float* sizes, std::vector<std::pair<int, int>>& out) const
+{
+	std::vector<int> hits;
+	for (int q : queries) {
+		hits.clear();
+		query(centers[q], sizes[q], hits);
+		for (int h : hits)
+			out.push_back(std::make_pair(q, h));
+	}
+}
+
+//slab test; distance is where the ray enters the box (0 when it starts inside)
+bool StaticBVH::rayHitsBox(const BVHRay& ray, glm::vec3 inverse, glm::vec3 min, glm::vec3 max, float maxDistance, float& distance) const
+{
+	float enter = 0.0f, leave = maxDistance;
+	for (int axis = 0; axis < 3; axis++) {
+		if (ray.direction[axis] == 0.0f) {
+			if (ray.origin[axis] < min[axis] || ray.origin[axis] > max[axis])
+				return false;
+			continue;
+		}
+		float t0 = (min[axis] - ray.origin[axis]) * inverse[axis];
+		float t1 = (max[axis] - ray.origin[axis]) * inverse[axis];
+		if (t0 > t1) std::swap(t0, t1);
+		enter = std::max(enter, t0);
+		leave = std::min(leave, t1);
+		if (enter > leave)
+			return false;
+	}
+	distance = enter;
+	return true;
+}
+
+BVHRayHit StaticBVH::raycast(const BVHRay& ray) const
+{
+	BVHRayHit hit{ -1, ray.maxDistance };
+	if (nodes.empty())
+		return hit;
+
+	glm::vec3 inverse(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+	float closest = ray.maxDistance;
+
+	int stack[64];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		int self = stack[--top];
+		const Node& node = nodes[self];
+		float entry;
+		if (!rayHitsBox(ray, inverse, node.min, node.max, closest, entry))
+			continue;
+
+		if (node.count > 0) {
+			for (int i = node.first; i < node.first + node.count; i++) {
+				const Item& item = items[i];
+				float half = item.size / 2;
+				if (rayHitsBox(ray, inverse, item.center - half, item.center + half, closest, entry)) {
+					if (hit.index < 0 || entry < closest || (entry == closest && item.index < hit.index)) {
+						closest = entry;
+						hit.index = item.index;
+						hit.distance = entry;
+					}
+				}
+			}
+		}
+		else {
+			stack[top++] = node.first;
+			stack[top++] = self + 1;
+		}
+	}
+	return hit;
+}
+
+void StaticBVH::raycastBatch(const std::vector<BVHRay>& rays, std::vector<BVHRayHit>& out) const
+{
+	out.clear();
+	out.reserve(rays.size());
+	for (const BVHRay& ray : rays)
+		out.push_back(raycast(ray));
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "glm\glm.hpp"
+#include <vector>
+#include <utility>
+
+/*************************************************
+
+	Bounding volume hierarchy for objects that
+	never move
+
+	Boxes are inserted with their center and
+	collider size, then build() sorts them into a
+	binary tree once. Overlap and ray queries only
+	walk the branches whose bounds they touch, so
+	a query costs roughly log(n) box tests instead
+	of n.
+
+	The tree is read-only after build(); queries
+	can run from several threads at once.
+
+**************************************************/
+
+struct BVHRay
+{
+	glm::vec3 origin;
+	glm::vec3 direction;	//does not need to be normalized; distances are in units of its length
+	float maxDistance;
+};
+
+struct BVHRayHit
+{
+	int index;		//-1 when the ray hit nothing
+	float distance;
+};
+
+class StaticBVH
+{
+	struct Item {
+		glm::vec3 center;
+		float size;
+		int index;			//index of the object in the caller's container
+	};
+
+	struct Node {
+		glm::vec3 min;
+		glm::vec3 max;
+		int first;			//leaf: first item; inner node: index of the right child (the left one follows the node)
+		int count;			//items in a leaf, 0 for an inner node
+	};
+
+	std::vector<Item> items;
+	std::vector<Node> nodes;
+
+	int buildNode(int first, int count);
+	bool rayHitsBox(const BVHRay& ray, glm::vec3 inverse, glm::vec3 min, glm::vec3 max, float maxDistance, float& distance) const;
+
+public:
+	void clear();
+
+	//adds an object; index is what the queries will report for it
+	void insert(int index, glm::vec3 center, float size);
+
+	//builds the tree over the inserted objects; must be called before any query
+	void build();
+
+	size_t size() const { return items.size(); }
+
+	//appends the index of every object overlapping the box; same test as an AABB overlap of two centered cubes
+	void query(glm::vec3 center, float size, std::vector<int>& out) const;
+
+	//runs query() for each of the boxes listed in queries (indices into centers and sizes)
+	//and appends (query, object) pairs in the order of queries
+	void queryBatch(const std::vector<int>& queries, const glm::vec3* centers, const float* sizes, std::vector<std::pair<int, int>>& out) const;
+
+	//closest object along the ray within its max distance
+	BVHRayHit raycast(const BVHRay& ray) const;
+
+	//one hit per ray, in the same order
+	void raycastBatch(const std::vector<BVHRay>& rays, std::vector<BVHRayHit>& out) const;
+};
@@ -0,0 +1,47 @@
+#include "StaticMesh.h"
+
+size_t StaticMesh::uploads = 0;
+size_t StaticMesh::uploadedBytes = 0;
+
+//creates the VAO and a buffer of the given size, left bound for filling in
+void StaticMesh::createBuffers(size_t bytes)
+{
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+	glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, bytes, NULL, GL_STATIC_DRAW);
+	uploads++;
+	uploadedBytes += bytes;
+}
+
+void StaticMesh::upload(GLenum primitive, const MeshVertex* vertices, GLsizei vertexCount)
+{
+	mode = primitive;
+	count = vertexCount;
+
+	createBuffers(vertexCount * sizeof(MeshVertex));
+	glBufferSubData(GL_ARRAY_BUFFER, 0, vertexCount * sizeof(MeshVertex), vertices);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), BUFFER_OFFSET(0));
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), BUFFER_OFFSET(sizeof(glm::vec3)));
+	glEnableVertexAttribArray(1);
+	glBindVertexArray(0);
+}
+
+void StaticMesh::upload(GLenum primitive, const GLfloat (*positions)[3], const GLfloat (*texCoords)[2], GLsizei vertexCount)
+{
+	mode = primitive;
+	count = vertexCount;
+
+	size_t positionBytes = vertexCount * sizeof(GLfloat[3]);
+	size_t texCoordBytes = vertexCount * sizeof(GLfloat[2]);
+	createBuffers(positionBytes + texCoordBytes);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, positionBytes, positions);
+	glBufferSubData(GL_ARRAY_BUFFER, positionBytes, texCoordBytes, texCoords);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, BUFFER_OFFSET(0));
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, BUFFER_OFFSET(positionBytes));
+	glEnableVertexAttribArray(1);
+	glBindVertexArray(0);
+}
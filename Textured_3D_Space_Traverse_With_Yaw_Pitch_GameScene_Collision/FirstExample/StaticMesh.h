@@ -0,0 +1,58 @@
+#pragma once
+#include "vgl.h"
+#include "glm\glm.hpp"
+
+/*************************************************
+
+	Static mesh
+
+	Geometry that never changes, uploaded once
+	into its own vertex buffer and vertex array
+	object. Drawing only binds the VAO and issues
+	the call; nothing goes to the driver again.
+
+	Vertices are position / texture coordinate
+	pairs, fed to triangles.vert as attributes 0
+	and 1. Every upload is counted, so a frame
+	that sends static geometry again shows up.
+
+**************************************************/
+
+struct MeshVertex
+{
+	glm::vec3 position;
+	glm::vec2 texCoord;
+};
+
+class StaticMesh
+{
+	GLuint vao = 0;
+	GLuint vbo = 0;
+	GLenum mode = GL_TRIANGLES;
+	GLsizei count = 0;
+
+	static size_t uploads;
+	static size_t uploadedBytes;
+
+	void createBuffers(size_t bytes);
+
+public:
+	//uploads the vertices; call once, with a GL context current
+	void upload(GLenum primitive, const MeshVertex* vertices, GLsizei vertexCount);
+
+	//same, from separate position and texture coordinate arrays; they share one buffer, positions first
+	void upload(GLenum primitive, const GLfloat (*positions)[3], const GLfloat (*texCoords)[2], GLsizei vertexCount);
+
+	//binds the mesh's VAO; glBindVertexArray(0) goes back to the default attribute setup
+	void bind() const { glBindVertexArray(vao); }
+
+	//draws the whole mesh; bind() first
+	void draw() const { glDrawArrays(mode, 0, count); }
+
+	GLenum primitive() const { return mode; }
+	GLsizei vertexCount() const { return count; }
+
+	//totals over every mesh since startup; they stop moving once loading is done
+	static size_t uploadCount() { return uploads; }
+	static size_t bytesUploaded() { return uploadedBytes; }
+};
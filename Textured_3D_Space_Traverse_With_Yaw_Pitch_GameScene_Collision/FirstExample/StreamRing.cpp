@@ -0,0 +1,69 @@
+#include "StreamRing.h"
+#include <chrono>
+
+StreamRing::~StreamRing()
+{
+	//the context may already be gone at exit; the driver frees everything with it
+}
+
+bool StreamRing::init(size_t bytesPerFrame)
+{
+	if (!GLEW_ARB_buffer_storage && !GLEW_VERSION_4_4)
+		return false;
+
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	regionSize = bytesPerFrame;
+	glGenBuffers(1, &buffer);
+	glBindBuffer(GL_ARRAY_BUFFER, buffer);
+	glBufferStorage(GL_ARRAY_BUFFER, regionSize * regionCount, NULL, flags);
+	mapped = (unsigned char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, regionSize * regionCount, flags);
+	if (mapped == nullptr) {
+		glDeleteBuffers(1, &buffer);
+		buffer = 0;
+		return false;
+	}
+	return true;
+}
+
+void StreamRing::beginFrame()
+{
+	if (!ready())
+		return;
+	region = (region + 1) % regionCount;
+	used = 0;
+
+	GLsync fence = fences[region];
+	if (fence == 0)
+		return;
+	GLenum status = glClientWaitSync(fence, 0, 0);
+	if (status == GL_TIMEOUT_EXPIRED) {
+		//the GPU is still reading this region from three frames ago
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		do
+			status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); //1 ms
+		while (status == GL_TIMEOUT_EXPIRED);
+		waits++;
+		waitMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+	glDeleteSync(fence);
+	fences[region] = 0;
+}
+
+void StreamRing::endFrame()
+{
+	if (!ready() || used == 0)
+		return;
+	fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void* StreamRing::allocate(size_t bytes, size_t alignment, GLintptr& offset)
+{
+	if (!ready())
+		return nullptr;
+	size_t start = (used + alignment - 1) & ~(alignment - 1);
+	if (start + bytes > regionSize)
+		return nullptr;
+	used = start + bytes;
+	offset = (GLintptr)(region * regionSize + start);
+	return mapped + offset;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "vgl.h"
+#include <cstddef>
+
+/*************************************************
+
+	Streaming ring buffer for per-frame GPU data
+
+	One buffer created with glBufferStorage and
+	mapped once, persistently and coherently, for
+	the life of the program. It is split into
+	three frame regions: the CPU fills one while
+	the GPU may still be reading the two before
+	it. A fence placed at the end of each frame
+	guards its region, so the CPU only ever waits
+	when it gets three frames ahead.
+
+	Writers get a pointer straight into the
+	mapping and the offset to draw from; there is
+	no map/unmap, orphaning or glBufferData per
+	frame.
+
+	Needs GL 4.4 or ARB_buffer_storage; init()
+	returns false without it and callers fall back
+	to re-specifying their own buffers.
+
+**************************************************/
+
+class StreamRing
+{
+	static const int regionCount = 3;
+
+	GLuint buffer = 0;
+	unsigned char* mapped = nullptr;
+	size_t regionSize = 0;
+	int region = 0;					//the one the CPU is filling
+	size_t used = 0;				//bytes handed out from it this frame
+	GLsync fences[regionCount] = {};
+
+public:
+	long long waits = 0;			//frames that had to wait for the GPU to release their region
+	double waitMs = 0.0;
+
+	~StreamRing();
+
+	//creates and maps a buffer of three regions of bytesPerFrame each; false if buffer storage is unsupported
+	bool init(size_t bytesPerFrame);
+
+	bool ready() const { return mapped != nullptr; }
+
+	//moves to the next region, waiting for the GPU to finish the frame that last used it
+	void beginFrame();
+
+	//fences the frame's region once its last draw has been issued
+	void endFrame();
+
+	//reserves bytes in this frame's region, aligned to alignment (a power of two). Returns where to
+	//write and sets offset to the buffer offset to draw from; nullptr when the region is full
+	void* allocate(size_t bytes, size_t alignment, GLintptr& offset);
+
+	GLuint id() const { return buffer; }
+};
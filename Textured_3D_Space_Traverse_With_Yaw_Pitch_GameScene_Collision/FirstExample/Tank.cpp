@@ -6,28 +6,25 @@
 #include "glm\gtx\rotate_vector.hpp"
 #include "camera.h"
 #include "Texture.h"
+#include "Meshes.h"
 #include <memory>
 #include <vector>
 #include "Player.h"
 #include "Bullet.h"
+#include "CollisionDispatch.h"
+#include "GameScene.h"
 
-extern std::vector<std::shared_ptr<GameObject>> gameScene;
 extern int gs; //gamestate
 
 Tank::Tank() : GameObject(glm::vec3(), glm::vec3(1, 0, 0))
 {
+	setTag(TAG_TANK);
 	float x = randomFloat(-25, 25); //spawns at a random point no further than 25 units from the center
 	float y = randomFloat(-25, 25); //spawns at a random point no further than 25 units from the center
 	setPosition(glm::vec3(x, y, 0.5f)); //sets its position
 	setMoveSpeed(randomFloat(0.75,1.25)); //sets its move speed
 	setDimensions(4.0, 2.4, 3.5); //sets the dimensions it will use for collision (x,y,z)
 
-	for (int i = 0; i < 4; i++)
-	{
-		getChildNodes().push_back(std::shared_ptr<GameObject>(new Wheel())); //adds 4 wheels
-	}
-
-
 	glm::vec3 v = glm::normalize(glm::vec3(randomFloat(-1, 1), randomFloat(-1, 1), 0.0)); //random direction, normalized
 
 	//normalization turns 0's into nan's for some reason... turn them back to 0's
@@ -41,63 +38,77 @@ Tank::Tank() : GameObject(glm::vec3(), glm::vec3(1, 0, 0))
 	setDirection(v); //set direction to the calculated direction
 };
 
-void Tank::updatePosition()
+void Tank::attachTransforms(TransformHierarchy& transforms)
 {
-
-	//setting position and direction of wheels
-	for (size_t i = 0; i < 4; i++)
-	{	
-		getChildNodes().at(i)->setPosition(getPosition() + (glm::rotateZ(wheelPositions[i], atan2(getDirection().x, -getDirection().y)))); //wheel positions rotate to match the main body
-		getChildNodes().at(i)->setDirection(getDirection()); //wheels face the same direction as the main body
+	bodyNode = transforms.allocate(nodeCount);
+	for (int i = 0; i < 4; i++)
+	{
+		//wheels used to be placed at atan2(x, -y), half a turn from the body's heading; negating the offset keeps each wheel where it was
+		transforms.setParent(bodyNode + 1 + i, bodyNode);
+		transforms.setLocal(bodyNode + 1 + i, glm::translate(glm::mat4(1), -wheelPositions[i]));
 	}
+	heading = getDirection();
+	headingRotation = glm::rotate(glm::mat4(1), atan2(-heading.x, heading.y), glm::vec3(0, 0, 1));
+	placeBody(transforms);
+}
+
+void Tank::detachTransforms(TransformHierarchy& transforms)
+{
+	transforms.release(bodyNode, nodeCount);
+	bodyNode = -1;
+}
 
-	//updates position of all children
-	for (size_t i = 0; i < getChildNodes().size(); i++)
-		getChildNodes().at(i)->updatePosition();
+//wheels follow the body through the hierarchy: one multiply each on the next update()
+void Tank::placeBody(TransformHierarchy& transforms)
+{
+	placedAt = getPosition();
+	transforms.setLocal(bodyNode, glm::translate(glm::mat4(1), placedAt) * headingRotation);
+}
 
-	
+void Tank::updatePosition()
+{
 	//moves the tank forward
 	setPosition(getPosition() + (getDirection() * (getMoveSpeed() * deltaTime / 1000.f)));
+
+	//the heading only changes when the direction does, so atan2 is not redone every frame
+	bool turned = getDirection() != heading;
+	if (turned)
+	{
+		heading = getDirection();
+		headingRotation = glm::rotate(glm::mat4(1), atan2(-heading.x, heading.y), glm::vec3(0, 0, 1));
+	}
+
+	//a tank that neither moved nor turned leaves its nodes clean, and update() skips them
+	if (turned || getPosition() != placedAt)
+		placeBody(gameScene.transforms);
 };
 
-void Tank::draw(){
-	glBindBuffer(GL_ARRAY_BUFFER, Buffers[0]);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertexMesh), vertexMesh, GL_STATIC_DRAW); //assigning the tank's vertex mesh to the vertex buffer
-	glBindBuffer(GL_ARRAY_BUFFER, Buffers[1]);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(textureMesh), textureMesh, GL_STATIC_DRAW); //assigning the tank's texture mesh to the texture buffer
+void Tank::initMeshes()
+{
+	Meshes::add(MeshID::tankMesh, GL_QUADS, vertexMesh, textureMesh, 24);
+	Meshes::add(MeshID::wheelMesh, GL_QUADS, Wheel::vertexMesh, Wheel::textureMesh, 16);
+}
 
-	glm::mat4 model_view = glm::mat4(1);
+void Tank::draw(){
+	Meshes::get(MeshID::tankMesh).bind(); //uploaded once by initMeshes()
 
-	model_view = glm::translate(model_view, getPosition()); //translate draw at object's location
-	//rotates tank to face its direction
-	model_view = glm::rotate(model_view, atan2(-getDirection().x, getDirection().y), glm::vec3(0, 0, 1));
-	model_view = glm::scale(model_view, glm::vec3(2.0, 2.0, 2.0));
+	//cached body transform: at the tank's location, facing its direction
+	glm::mat4 model_view = glm::scale(gameScene.transforms.getWorld(bodyNode), glm::vec3(2.0, 2.0, 2.0));
 	glUniformMatrix4fv(location, 1, GL_FALSE, &model_view[0][0]);
 
 
 	glBindTexture(GL_TEXTURE_2D, Texture::get(TextureID::tank));
 	glDrawArrays(GL_QUADS, 0, 24);
+
+	Meshes::get(MeshID::wheelMesh).bind();
+	for (int i = 1; i <= 4; i++)
+		Wheel::draw(gameScene.transforms.getWorld(bodyNode + i)); //wheels use the tank texture that is still bound
+	glBindVertexArray(0);
 }
 
 void Tank::checkCollision(GameObject* other)
 {
-	//assignment will return NULL if cast is invalid
-	if (auto c_player = dynamic_cast<Player*>(other)) { //if being compared with a player...
-		if (isColliding(c_player)) {//if the two bodies intersect...
-			willBeErased = true; //mark the object for deletion
-		}
-	}
-	else if (auto bullet = dynamic_cast<Bullet*>(other)) { //if being compared with a bullet...
-		if (isColliding(bullet)) {//if the two bodies intersect...
-			if (bullet->getSource() != nullptr) {
-				if (auto source = dynamic_cast<Player*>(bullet->getSource())) //it is colliding with the PLAYER'S bullet
-				{
-					willBeErased = true; //mark the object for deletion
-					::player->incTanksShot(); //increment number of tanks shot
-				}
-			}
-		}
-	}
+	respondToCollision(this, other); //response is looked up by the (tank, other) tag pair; see CollisionDispatch.cpp
 }
 
 void Tank::idle()
@@ -114,39 +125,30 @@ void Tank::idle()
 			v.y = 0;
 		if (glm::isnan(v.z))
 			v.z = 0;
-		gameScene.push_back(std::shared_ptr<GameObject>(new Bullet(getPosition(),v, this)));
+		gameScene.add(Bullet(getPosition(), v, getHandle())); //constructed in a pooled slot; no allocation once the pool has grown
 		lastBulletShot = time;
 	}
 }
 
-void Tank::Wheel::draw()
+//the wheel mesh is already bound by Tank::draw
+void Tank::Wheel::draw(const glm::mat4& world)
 {
-	glBindBuffer(GL_ARRAY_BUFFER, Buffers[0]);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertexMesh), vertexMesh, GL_STATIC_DRAW); //assigning the tank wheel's vertex mesh to the vertex buffer
-	glBindBuffer(GL_ARRAY_BUFFER, Buffers[1]);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(textureMesh), textureMesh, GL_STATIC_DRAW); //assigning the tank wheel's texture mesh to the texture buffer
-
-	glm::mat4 model_view = glm::mat4(1);
-
-	glm::vec3 side_vector = glm::cross(getDirection(), glm::vec3(0, 0, 1)); //side vector, used for rotating the wheel
-
-	model_view = glm::translate(model_view, getPosition()); //draw at wheel's position
+	//world already faces the tank's direction, so the axle is the local x axis
+	glm::mat4 model_view = world;
 	if (gs == 0) {
-		model_view = glm::rotate(model_view, -glutGet(GLUT_ELAPSED_TIME) / 500.f, side_vector); //constant rotation of the wheel
+		model_view = glm::rotate(model_view, -glutGet(GLUT_ELAPSED_TIME) / 500.f, glm::vec3(1, 0, 0)); //constant rotation of the wheel
 	}
 	model_view = glm::scale(model_view, glm::vec3(0.5, 0.5, 0.5)); 
 
 
 	for (size_t i = 0; i < 6; i++) //drawing each face of the wheel individually, rotating and reusing the vertices
 	{
-		model_view = glm::rotate(model_view, glm::radians(60.f), side_vector); 
-		glm::mat4 model_view2 = glm::rotate(model_view, atan2(-getDirection().x, getDirection().y), glm::vec3(0, 0, 1)); //making a second matrix to hold the rotation that faces its direction, this is done so that it does not mess with other rotations
-		glUniformMatrix4fv(location, 1, GL_FALSE, &model_view2[0][0]);
+		model_view = glm::rotate(model_view, glm::radians(60.f), glm::vec3(1, 0, 0)); 
+		glUniformMatrix4fv(location, 1, GL_FALSE, &model_view[0][0]);
 		glDrawArrays(GL_QUADS, 12, 4);
 	}
 
-	//rotate the wheel to face its direction
-	model_view = glm::rotate(model_view, atan2(-getDirection().x, getDirection().y), glm::vec3(0, 0, 1));
+	//six turns of 60 degrees bring the matrix back to the wheel's own rotation
 	glUniformMatrix4fv(location, 1, GL_FALSE, &model_view[0][0]);
 
 	glDrawArrays(GL_POLYGON, 0, 6); //draw face of wheel
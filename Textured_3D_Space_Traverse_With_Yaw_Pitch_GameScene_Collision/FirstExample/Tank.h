@@ -10,6 +10,7 @@
 #pragma once
 #include "GameObject.h"
 #include "glm\glm.hpp"
+#include "TransformHierarchy.h"
 
 //Tank class
 class Tank : public GameObject
@@ -19,9 +20,26 @@ class Tank : public GameObject
 	static glm::vec3 wheelPositions[4]; //array of vectors representing the positions of the wheels as offsets from the center of the tank
 
 	int lastBulletShot = glutGet(GLUT_ELAPSED_TIME);
+
+	int bodyNode = -1; //first of the tank's nodes in gameScene.transforms: the body, then the 4 wheels
+	glm::vec3 heading = glm::vec3(0, 0, 0); //direction the heading rotation was built for
+	glm::mat4 headingRotation = glm::mat4(1);
+	glm::vec3 placedAt = glm::vec3(0, 0, 0); //position the body node was last set for
+
+	void placeBody(TransformHierarchy& transforms);
 public:
+	static const int nodeCount = 5;
+
 	Tank();
 
+	//takes the tank's nodes in the scene's hierarchy; called by GameScene::add once the tank is in its pool
+	void attachTransforms(TransformHierarchy& transforms);
+
+	//gives the nodes back; called by GameScene when the tank is erased
+	void detachTransforms(TransformHierarchy& transforms);
+
+	static void initMeshes(); //uploads the body and wheel meshes once; call at startup, after the GL context exists
+
 	virtual void updatePosition();
 
 	virtual void draw();
@@ -31,16 +49,14 @@ public:
 	virtual void idle();
 
 private:
-	class Wheel : public GameObject
+	//wheels are drawn by the tank from its cached transforms; they are not scene objects of their own
+	class Wheel
 	{
+		friend class Tank; //uploads the wheel mesh
 		static GLfloat vertexMesh[16][3];
 		static GLfloat textureMesh[16][2];
 
 	public:
-		virtual void updatePosition() {}; //has no children; no need to update child positions
-
-		virtual void draw(); 
-
-		virtual void checkCollision(GameObject* other) {} //has no collision; collision is handled by the main body
+		static void draw(const glm::mat4& world);
 	};
 };
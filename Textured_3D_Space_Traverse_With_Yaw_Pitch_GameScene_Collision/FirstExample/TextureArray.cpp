@@ -0,0 +1,107 @@
+#include "TextureArray.h"
+#include <algorithm>
+#include <cstring>
+
+void TextureArray::add(GLuint texture, const unsigned char* pixels, int width, int height, int channels, bool flipY)
+{
+	Entry e;
+	e.texture = texture;
+	e.width = width;
+	e.height = height;
+	e.layer = -1;
+	e.x = e.y = 0;
+	e.rgba.resize((size_t)width * height * 4);
+	for (int row = 0; row < height; row++) {
+		const unsigned char* src = pixels + (size_t)(flipY ? height - 1 - row : row) * width * channels;
+		unsigned char* dst = &e.rgba[(size_t)row * width * 4];
+		for (int col = 0; col < width; col++) {
+			dst[col * 4 + 0] = src[col * channels + 0];
+			dst[col * 4 + 1] = src[col * channels + 1];
+			dst[col * 4 + 2] = src[col * channels + 2];
+			dst[col * 4 + 3] = channels == 4 ? src[col * channels + 3] : 255;
+		}
+	}
+	entries.push_back(e);
+}
+
+bool TextureArray::build(GLuint program)
+{
+	//a sampler2DArray left on unit 0 with sampler2D makes every draw invalid, built or not
+	glUniform1i(glGetUniformLocation(program, "textureArray"), textureUnit);
+	if (entries.empty() || entries.size() > maxEntries)
+		return false;
+
+	size = 0;
+	for (const Entry& e : entries)
+		size = std::max(size, std::max(e.width, e.height));
+
+	//full size images get a layer each
+	layers = 0;
+	std::vector<int> odd;
+	for (int i = 0; i < (int)entries.size(); i++) {
+		if (entries[i].width == size && entries[i].height == size)
+			entries[i].layer = layers++;
+		else
+			odd.push_back(i);
+	}
+
+	//the rest go on shelves, tallest first, opening a new atlas layer when one fills up
+	std::sort(odd.begin(), odd.end(), [this](int a, int b) { return entries[a].height > entries[b].height; });
+	int atlas = -1, x = 0, y = 0, shelfHeight = 0;
+	for (int i : odd) {
+		Entry& e = entries[i];
+		if (atlas >= 0 && x + e.width > size) {
+			x = 0;
+			y += shelfHeight + gutter;
+			shelfHeight = 0;
+		}
+		if (atlas < 0 || y + e.height > size) {
+			atlas = layers++;
+			x = y = shelfHeight = 0;
+		}
+		e.layer = atlas;
+		e.x = x;
+		e.y = y;
+		x += e.width + gutter;
+		shelfHeight = std::max(shelfHeight, e.height);
+	}
+
+	std::vector<unsigned char> texels((size_t)size * size * 4 * layers, 0);
+	for (const Entry& e : entries)
+		for (int row = 0; row < e.height; row++)
+			memcpy(&texels[(((size_t)e.layer * size + e.y + row) * size + e.x) * 4], &e.rgba[(size_t)row * e.width * 4], (size_t)e.width * 4);
+
+	glGenTextures(1, &array);
+	glActiveTexture(GL_TEXTURE0 + textureUnit);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, array);
+	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, size, size, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+	//bilinear but no mipmaps: the inset rectangles below keep bilinear taps inside an entry, while
+	//coarser levels would average neighbouring atlas entries together once they shrink past the gutter
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glActiveTexture(GL_TEXTURE0);
+
+	//rectangles are inset by half a texel so bilinear filtering never reaches into a neighbour or the gutter
+	std::vector<glm::vec4> rects;
+	std::vector<GLint> entryLayers;
+	for (Entry& e : entries) {
+		rects.push_back(glm::vec4(e.x + 0.5f, e.y + 0.5f, e.width - 1.0f, e.height - 1.0f) / (float)size);
+		entryLayers.push_back(e.layer);
+		std::vector<unsigned char>().swap(e.rgba);
+	}
+	glUniform4fv(glGetUniformLocation(program, "entryRects"), (GLsizei)rects.size(), &rects[0][0]);
+	glUniform1iv(glGetUniformLocation(program, "entryLayers"), (GLsizei)entryLayers.size(), entryLayers.data());
+	return true;
+}
+
+int TextureArray::entryOf(GLuint texture) const
+{
+	if (array == 0)
+		return -1;
+	for (int i = 0; i < (int)entries.size(); i++)
+		if (entries[i].texture == texture)
+			return i;
+	return -1;
+}
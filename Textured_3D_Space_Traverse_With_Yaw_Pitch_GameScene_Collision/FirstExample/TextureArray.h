@@ -0,0 +1,65 @@
+#pragma once
+#include "vgl.h"
+#include "glm\glm.hpp"
+#include <vector>
+
+/*************************************************
+
+	Texture array
+
+	Packs the scene's textures into the layers of
+	one GL_TEXTURE_2D_ARRAY so every instanced
+	batch can be drawn with a single bind. The
+	layer size is the largest image added: images
+	of exactly that size get a layer each, and
+	the others are shelf packed, several to a
+	layer, as an atlas.
+
+	Each texture becomes an entry with a layer and
+	a rectangle inside it. triangles.frag holds
+	the entries in a uniform table and instances
+	pick theirs by index (attribute 4, see
+	InstancedBatches), wrapping the mesh's texture
+	coordinates into the rectangle.
+
+	Textures keep their own GL_TEXTURE_2D as well;
+	entryOf() maps that name to the entry, so the
+	rest of the game keeps passing texture names.
+
+**************************************************/
+
+class TextureArray
+{
+	struct Entry {
+		GLuint texture;					//the GL_TEXTURE_2D this stands in for
+		int width, height;
+		std::vector<unsigned char> rgba;	//until build()
+		int layer;
+		int x, y;						//texels, within the layer
+	};
+
+	GLuint array = 0;
+	int size = 0;						//width and height of every layer
+	int layers = 0;
+	std::vector<Entry> entries;
+
+public:
+	static const int maxEntries = 16;	//the size of the table in triangles.frag
+	static const GLint textureUnit = 1;	//sampler2D texture stays on unit 0
+	static const int gutter = 2;		//empty texels between atlas entries
+
+	//copies an image in for the next build(); channels is 3 or 4, flipY for images loaded upside down
+	void add(GLuint texture, const unsigned char* pixels, int width, int height, int channels, bool flipY = false);
+
+	//packs and uploads the layers and fills in the entry table of the linked (and current) triangles program;
+	//always moves the program's textureArray sampler to textureUnit, so a failed build still leaves it drawable
+	bool build(GLuint program);
+
+	//the entry standing in for a GL_TEXTURE_2D, -1 if it was not added or the array is not built
+	int entryOf(GLuint texture) const;
+
+	GLuint id() const { return array; }
+	int layerSize() const { return size; }
+	int layerCount() const { return layers; }
+	int entryCount() const { return (int)entries.size(); }
+};
@@ -0,0 +1,147 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+/*************************************************
+
+	Hierarchical timing wheel
+
+	Events are filed by the tick they are due on.
+	Level 0 has one slot per tick for the next 64
+	ticks; every level above covers 64 times the
+	span of the one below. When a lower level wraps
+	around, the matching slot of the next level is
+	re-filed one level down, so each event is only
+	touched a handful of times before it fires,
+	however many events are pending.
+
+	advance() hands back only the events that are
+	due, in the order they were filed.
+
+**************************************************/
+
+template <typename T>
+class TimingWheel
+{
+	static const int slotBits = 6;
+	static const int slotsPerLevel = 1 << slotBits;
+	static const int levels = 4;
+
+	struct Entry {
+		long long due;
+		T payload;
+	};
+
+	std::vector<Entry> slots[levels][slotsPerLevel];
+	std::vector<Entry> overflow;	//further out than the top level reaches
+	std::vector<Entry> overdue;		//scheduled for a tick that has already passed
+	long long current = 0;
+	size_t count = 0;
+
+	//files an entry that is due at or after the current tick
+	void place(const Entry& e)
+	{
+		long long delta = e.due - current;
+		for (int level = 0; level < levels; level++) {
+			if (delta < (1LL << (slotBits * (level + 1)))) {
+				slots[level][(e.due >> (slotBits * level)) & (slotsPerLevel - 1)].push_back(e);
+				return;
+			}
+		}
+		overflow.push_back(e);
+	}
+
+	//re-files a bucket after the level below it has wrapped
+	void cascade(std::vector<Entry>& bucket)
+	{
+		std::vector<Entry> moving;
+		moving.swap(bucket);
+		for (const Entry& e : moving)
+			place(e);
+	}
+
+public:
+	//the wheel starts at this tick; call before scheduling anything
+	void reset(long long tick)
+	{
+		for (int level = 0; level < levels; level++)
+			for (int s = 0; s < slotsPerLevel; s++)
+				slots[level][s].clear();
+		overflow.clear();
+		overdue.clear();
+		current = tick;
+		count = 0;
+	}
+
+	//files an event for a tick; ticks at or before the current one fire on the next advance()
+	void schedule(long long dueTick, const T& payload)
+	{
+		if (dueTick <= current)
+			overdue.push_back(Entry{ dueTick, payload });
+		else
+			place(Entry{ dueTick, payload });
+		count++;
+	}
+
+	//moves the wheel up to tick now and appends the payload of every event that came due to out
+	void advance(long long now, std::vector<T>& out)
+	{
+		for (const Entry& e : overdue)
+			out.push_back(e.payload);
+		count -= overdue.size();
+		overdue.clear();
+
+		while (current < now) {
+			current++;
+
+			for (int level = 1; level < levels; level++) {
+				if ((current & ((1LL << (slotBits * level)) - 1)) != 0)
+					break;
+				cascade(slots[level][(current >> (slotBits * level)) & (slotsPerLevel - 1)]);
+			}
+			if ((current & ((1LL << (slotBits * levels)) - 1)) == 0)
+				cascade(overflow);
+
+			std::vector<Entry>& due = slots[0][current & (slotsPerLevel - 1)];
+			for (const Entry& e : due)
+				out.push_back(e.payload);
+			count -= due.size();
+			due.clear();
+		}
+	}
+
+	long long now() const { return current; }
+	size_t pending() const { return count; }
+
+	//where visitPending() found an entry: level * 64 + slot, below filedSlots, or one of these
+	static const int filedSlots = levels * slotsPerLevel;
+	static const int filedOverflow = -1;
+	static const int filedOverdue = -2;
+
+	//calls visit(place, due, payload) on every pending event; filing them back in the
+	//same order with file() rebuilds the wheel exactly, down to the order events fire in
+	template <typename F>
+	void visitPending(F visit) const
+	{
+		for (int level = 0; level < levels; level++)
+			for (int s = 0; s < slotsPerLevel; s++)
+				for (const Entry& e : slots[level][s])
+					visit(level * slotsPerLevel + s, e.due, e.payload);
+		for (const Entry& e : overflow)
+			visit(filedOverflow, e.due, e.payload);
+		for (const Entry& e : overdue)
+			visit(filedOverdue, e.due, e.payload);
+	}
+
+	//puts an event back where visitPending() reported it; reset() to the saved tick first
+	void file(int place, long long due, const T& payload)
+	{
+		if (place == filedOverdue)
+			overdue.push_back(Entry{ due, payload });
+		else if (place == filedOverflow || place < 0 || place >= levels * slotsPerLevel)
+			overflow.push_back(Entry{ due, payload });
+		else
+			slots[place / slotsPerLevel][place % slotsPerLevel].push_back(Entry{ due, payload });
+		count++;
+	}
+};
@@ -0,0 +1,107 @@
+#include "Benchmarks.h"
+#include "World.h"
+#include "TransformHierarchy.h"
+#include "glm\gtc\matrix_transform.hpp"
+#include <cstdio>
+#include <algorithm>
+#include <cmath>
+
+// Tanks laid out the way Tank::attachTransforms() builds them: a body node and four wheels parented
+// to it. The world matrices update() caches are checked against parent * local worked out directly,
+// after everything is placed and again after only some bodies moved, so a subtree that missed its
+// parent's dirty flag shows up. Then released runs must come back for runs of the same length.
+
+static const int transformBenchNodes = 5;     // as Tank::nodeCount
+static const glm::vec3 transformBenchWheels[4] = {
+    glm::vec3(-1.25f, -1.35f, 0.0f), glm::vec3(-1.25f, 1.35f, 0.0f), glm::vec3(1.25f, 1.35f, 0.0f), glm::vec3(1.25f, -1.35f, 0.0f)
+};
+
+static glm::mat4 bodyMatrix(WorldRandom& rng) {
+    glm::vec3 position(rng.uniform(-100, 100), rng.uniform(-100, 100), 0.0f);
+    return glm::rotate(glm::translate(glm::mat4(1), position), rng.uniform(-3.14159f, 3.14159f), glm::vec3(0, 0, 1));
+}
+
+static glm::mat4 wheelMatrix(int wheel) {
+    return glm::translate(glm::mat4(1), -transformBenchWheels[wheel]);
+}
+
+// Largest difference between a cached world matrix and the one it should hold
+static float worldError(const TransformHierarchy& transforms, const std::vector<int>& firsts, const std::vector<glm::mat4>& bodies) {
+    float error = 0;
+    for (size_t t = 0; t < firsts.size(); t++) {
+        for (int node = 0; node < transformBenchNodes; node++) {
+            glm::mat4 expected = node == 0 ? bodies[t] : bodies[t] * wheelMatrix(node - 1);
+            const glm::mat4& world = transforms.getWorld(firsts[t] + node);
+            for (int c = 0; c < 4; c++)
+                for (int r = 0; r < 4; r++)
+                    error = std::max(error, std::fabs(world[c][r] - expected[c][r]));
+        }
+    }
+    return error;
+}
+
+int runTransformBenchmark(int tanks) {
+    tanks = std::max(2, tanks);
+    const int updates = 100;
+    const float tolerance = 1e-4f;
+    WorldRandom rng;
+    rng.seed(1);
+
+    TransformHierarchy transforms;
+    std::vector<int> firsts(tanks);
+    std::vector<glm::mat4> bodies(tanks);
+    for (int t = 0; t < tanks; t++) {
+        firsts[t] = transforms.allocate(transformBenchNodes);
+        for (int wheel = 0; wheel < 4; wheel++) {
+            transforms.setParent(firsts[t] + 1 + wheel, firsts[t]);
+            transforms.setLocal(firsts[t] + 1 + wheel, wheelMatrix(wheel));
+        }
+        bodies[t] = bodyMatrix(rng);
+        transforms.setLocal(firsts[t], bodies[t]);
+    }
+    transforms.update();
+    float placedError = worldError(transforms, firsts, bodies);
+
+    // Every tenth body moves; its wheels are only reached through the parent's dirty flag
+    for (int t = 0; t < tanks; t += 10) {
+        bodies[t] = bodyMatrix(rng);
+        transforms.setLocal(firsts[t], bodies[t]);
+    }
+    transforms.update();
+    float movedError = worldError(transforms, firsts, bodies);
+
+    printf("%d tanks, %d nodes\n", tanks, (int)transforms.size());
+
+    // update() cost with every body moving, a tenth of them, and none
+    const int strides[] = { 1, 10, 0 };
+    const char* labels[] = { "all moving", "a tenth moving", "none moving" };
+    for (int s = 0; s < 3; s++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int u = 0; u < updates; u++) {
+            for (int t = 0; strides[s] > 0 && t < tanks; t += strides[s])
+                transforms.setLocal(firsts[t], bodies[t]);
+            transforms.update();
+        }
+        printf("  %-15s %.3f ms per update\n", labels[s], elapsedMs(start) / updates);
+    }
+
+    // Half the runs are released and taken again: same length reuses them, another length does not
+    size_t nodes = transforms.size();
+    std::vector<int> released;
+    for (int t = 0; t < tanks; t += 2) {
+        transforms.release(firsts[t], transformBenchNodes);
+        released.push_back(firsts[t]);
+    }
+    int otherLength = transforms.allocate(transformBenchNodes - 1);
+    bool reused = otherLength == (int)nodes;
+    for (size_t r = 0; r < released.size(); r++) {
+        int first = transforms.allocate(transformBenchNodes);
+        reused = reused && std::find(released.begin(), released.end(), first) != released.end();
+    }
+    reused = reused && transforms.size() == nodes + transformBenchNodes - 1;
+
+    bool ok = placedError <= tolerance && movedError <= tolerance && reused;
+    printf("  placed error %g, after a tenth moved %g, released runs %s%s\n",
+        placedError, movedError, reused ? "reused" : "not reused", ok ? "" : " (MISMATCH)");
+    return ok ? 0 : 1;
+}
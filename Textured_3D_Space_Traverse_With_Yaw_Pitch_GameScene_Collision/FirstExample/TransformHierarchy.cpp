@@ -0,0 +1,64 @@
+#include "TransformHierarchy.h"
+#include <algorithm>
+#include <cassert>
+
+int TransformHierarchy::allocate(int count)
+{
+	int first = -1;
+	for (size_t r = freeRuns.size(); r-- > 0;) {
+		if (freeRuns[r].y == count) {
+			first = freeRuns[r].x;
+			freeRuns.erase(freeRuns.begin() + r);
+			break;
+		}
+	}
+	if (first < 0) {
+		first = (int)parent.size();
+		parent.resize(first + count);
+		local.resize(first + count);
+		world.resize(first + count);
+		dirty.resize(first + count);
+	}
+
+	for (int node = first; node < first + count; node++) {
+		parent[node] = -1;
+		local[node] = glm::mat4(1);
+		dirty[node] = 1;
+	}
+	return first;
+}
+
+void TransformHierarchy::release(int first, int count)
+{
+	for (int node = first; node < first + count; node++) {
+		parent[node] = -1;
+		dirty[node] = 0;
+	}
+	freeRuns.push_back(glm::ivec2(first, count));
+}
+
+void TransformHierarchy::setParent(int node, int parentNode)
+{
+	assert(parentNode < node); //parents must come first
+	parent[node] = parentNode;
+	dirty[node] = 1;
+}
+
+void TransformHierarchy::setLocal(int node, const glm::mat4& localMatrix)
+{
+	local[node] = localMatrix;
+	dirty[node] = 1;
+}
+
+void TransformHierarchy::update()
+{
+	for (size_t i = 0; i < parent.size(); i++) {
+		int p = parent[i];
+		if (p >= 0 && dirty[p])
+			dirty[i] = 1; //the parent moved, so this subtree moves with it
+		if (!dirty[i])
+			continue;
+		world[i] = p >= 0 ? world[p] * local[i] : local[i];
+	}
+	std::fill(dirty.begin(), dirty.end(), 0);
+}
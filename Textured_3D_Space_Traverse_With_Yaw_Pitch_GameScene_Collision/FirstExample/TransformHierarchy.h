@@ -0,0 +1,62 @@
+#pragma once
+#include "glm\glm.hpp"
+#include <vector>
+#include <cstdint>
+
+/*************************************************
+
+	Flattened transform hierarchy
+
+	One per scene. Nodes are stored in flat arrays
+	and a node's parent always has a lower index,
+	so one front-to-back pass over the arrays sees
+	every parent's world matrix before its
+	children need it.
+
+	Objects take a run of consecutive nodes with
+	allocate() and give it back with release().
+	A released run is reused for the next run of
+	the same length, so an object's layout inside
+	its run, parents first, is kept.
+
+	setLocal() marks a node dirty. update() only
+	recomputes world = parent world * local for
+	dirty nodes and the nodes under them, then
+	clears the flags. Drawing reads the cached
+	world matrices.
+
+**************************************************/
+
+class TransformHierarchy
+{
+	std::vector<int> parent;		//-1 for a root or a released node
+	std::vector<glm::mat4> local;
+	std::vector<glm::mat4> world;
+	std::vector<uint8_t> dirty;
+	std::vector<glm::ivec2> freeRuns;	//first node and length of each released run
+
+public:
+	//takes count consecutive nodes, all roots with an identity local matrix; returns the first
+	int allocate(int count);
+
+	//gives a run back; its nodes stop being updated until they are allocated again
+	void release(int first, int count);
+
+	//parentNode must have a lower index than node, or be -1
+	void setParent(int node, int parentNode);
+
+	void setLocal(int node, const glm::mat4& localMatrix);
+
+	//brings the world matrices of dirty nodes and their subtrees up to date; once a frame, after everything has moved
+	void update();
+
+	const glm::mat4& getWorld(int node) const
+	{
+		return world[node];
+	}
+
+	size_t size() const
+	{
+		return parent.size();
+	}
+};
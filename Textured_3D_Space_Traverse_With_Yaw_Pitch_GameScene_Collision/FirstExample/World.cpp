@@ -0,0 +1,587 @@
+﻿#include "World.h"
+#include "JobSystem.h"
+#include "Logger.h"
+#include "glm\gtx\rotate_vector.hpp"
+#include <algorithm>
+#include <cmath>
+
+const size_t contactChunkSize = 1024;
+const size_t enemyChunkSize = 2048;
+const float flowFieldMargin = 10.0f; // free space kept around the obstacle area
+
+double elapsedMs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+bool aabbOverlap(glm::vec3 a, GLfloat sizeA, glm::vec3 b, GLfloat sizeB) {
+    return glm::abs(a.x - b.x) <= (sizeA / 2 + sizeB / 2) &&
+        glm::abs(a.y - b.y) <= (sizeA / 2 + sizeB / 2) &&
+        glm::abs(a.z - b.z) <= (sizeA / 2 + sizeB / 2);
+}
+
+// PCG32 (O'Neill): 64-bit LCG state, output permuted by an xorshift and a data-dependent rotation
+void WorldRandom::seed(uint64_t s) {
+    state = 0;
+    increment = (s << 1) | 1;
+    next();
+    state += s;
+    next();
+}
+
+uint32_t WorldRandom::next() {
+    uint64_t old = state;
+    state = old * 6364136223846793005ULL + increment;
+    uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+    uint32_t rotation = (uint32_t)(old >> 59);
+    return (xorshifted >> rotation) | (xorshifted << ((0u - rotation) & 31));
+}
+
+World::World()
+    : sceneGrid(2.0f), enemyGrid(2.0f), enemyFlow(1.0f)
+{
+    rng.seed(1);
+}
+
+// Chunks run on the world's job system if it has one, otherwise in order on this thread
+template <typename F>
+void World::parallelFor(size_t count, size_t grain, const F& job) {
+    if (jobs != nullptr) {
+        jobs->parallelFor(count, grain, job);
+        return;
+    }
+    for (size_t begin = 0; begin < count; begin += grain)
+        job(begin, std::min(count, begin + grain), 0u);
+}
+
+// Files an event for the first tick at or after the given simulated time
+void World::scheduleAt(int dueSimTime, int kind, EntityHandle target) {
+    timers.schedule((dueSimTime + simTickMs - 1) / simTickMs, TimedEvent{ kind, target });
+}
+
+void World::scheduleNextSpawn() {
+    int ticks = std::max(1, (int)std::ceil(spawnInterval / simTickMs));
+    timers.schedule(simTime / simTickMs + ticks, TimedEvent{ ENEMY_SPAWN, EntityHandle{ -1, 0 } });
+}
+
+int World::pickUpdateBand(float distance) const {
+    int band = 0;
+    while (band + 1 < (int)updateBands.size() && distance >= updateBands[band + 1].minDistance)
+        band++;
+    return band;
+}
+
+GameObject World::makeEnemy(glm::vec3 position) {
+    GameObject enemy;
+    enemy.scale = glm::vec3(1.0f);
+    enemy.location = position;
+    enemy.rotation = glm::vec3(0.0f);
+    enemy.type = ENEMY;
+    enemy.velocity = 0.003f + (rng.next() % 5) * 0.001f;
+    enemy.isAlive = true;
+    enemy.collider_dimension = 0.9f;
+    enemy.isCollided = false;
+    enemy.living_time = 0;
+    enemy.life_span = -1;
+    enemy.textureID = enemyTexture;
+    enemy.moving_direction = glm::vec3(0.0f);
+    enemy.lastShotTime = simTime;
+    enemy.owner = 1;
+    enemy.lastUpdateTime = simTime;
+    return enemy;
+}
+
+GameObject World::makeBullet(glm::vec3 position, glm::vec3 direction, GLfloat velocity, int owner) {
+    GameObject bullet;
+    bullet.owner = owner;
+    bullet.lastUpdateTime = simTime;
+    bullet.location = position;
+    bullet.rotation = glm::vec3(0);
+    bullet.scale = glm::vec3(0.07f);
+    bullet.collider_dimension = bullet.scale.x;
+    bullet.isAlive = true;
+    bullet.living_time = 0;
+    bullet.isCollided = false;
+    bullet.velocity = velocity;
+    bullet.type = BULLET;
+    bullet.moving_direction = direction;
+    bullet.life_span = 4000;
+    bullet.textureID = bulletTexture;
+    bullet.lastShotTime = 0;
+    return bullet;
+}
+
+// A bullet is alive for life_span ms of movement; it expires on the tick after its last step
+void World::addBullet(const GameObject& bullet) {
+    EntityHandle handle = sceneGraph.spawn(bullet);
+    scheduleAt(simTime + bullet.life_span + simTickMs, BULLET_EXPIRY, handle);
+}
+
+// An enemy fires on the first tick more than enemyShootCooldown ms after its last shot
+void World::addEnemy(const GameObject& enemy) {
+    EntityHandle handle = enemyList.spawn(enemy);
+    scheduleAt(enemy.lastShotTime + enemyShootCooldown + 1, ENEMY_FIRE, handle);
+}
+
+void World::spawnEnemy() {
+    float x = (float)((int)(rng.next() % 40) - 20);
+    float z = (float)((int)(rng.next() % 40) - 20);
+
+    // Prevent too-close spawn
+    float distanceToPlayer = glm::length(glm::vec2(x - cam_pos.x, z - cam_pos.z));
+    if (distanceToPlayer < 5.0f) return;
+
+    GameObject enemy = makeEnemy(glm::vec3(x, 0.5f, z));  // Set Y to 0.5 to rest on ground
+    enemy.lastUpdateTime = simTime - simTickMs;  // spawned mid-tick; its first update covers the whole tick like everyone else's
+    addEnemy(enemy);
+}
+
+void World::detectContacts() {
+    // The broadphase grid only hands back objects from neighbouring cells; the overlap test is symmetric so each pair is tested once
+    sceneGrid.clear();
+    for (size_t i = 0; i < sceneGraph.size(); i++) {
+        if (sceneGraph.isAlive[i] && sceneGraph.type[i] != OBSTACLE)
+            sceneGrid.insert((int)i, sceneGraph.location[i], sceneGraph.collider_dimension[i]);
+    }
+    sceneGrid.build();
+
+    enemyGrid.clear();
+    for (size_t j = 0; j < enemyList.size(); j++) {
+        if (enemyList.isAlive[j])
+            enemyGrid.insert((int)j, enemyList.location[j], enemyList.collider_dimension[j]);
+    }
+    enemyGrid.build();
+
+    size_t chunks = (sceneGraph.size() + contactChunkSize - 1) / contactChunkSize;
+    if (contactChunkOutputs.size() < chunks)
+        contactChunkOutputs.resize(chunks);
+
+    parallelFor(sceneGraph.size(), contactChunkSize, [this](size_t begin, size_t end, unsigned) {
+        ContactChunkOutput& out = contactChunkOutputs[begin / contactChunkSize];
+        out.overlaps.clear();
+        out.enemyHits.clear();
+        out.playerHits.clear();
+        out.movers.clear();
+
+        for (size_t i = begin; i < end; i++) {
+            if (!sceneGraph.isAlive[i] || sceneGraph.type[i] == OBSTACLE) continue;
+            out.movers.push_back((int)i);
+
+            // Moving objects against each other (e.g., bullets hitting bullets)
+            sceneGrid.query(sceneGraph.location[i], sceneGraph.collider_dimension[i], out.candidates);
+            for (int j : out.candidates) {
+                if (j > (int)i) {
+                    if (aabbOverlap(sceneGraph.location[i], sceneGraph.collider_dimension[i], sceneGraph.location[j], sceneGraph.collider_dimension[j]))
+                        out.overlaps.push_back(Contact{ OVERLAP, (int)i, j });
+                }
+            }
+
+            if (sceneGraph.type[i] != BULLET) continue;
+
+            if (sceneGraph.owner[i] != 1) {
+                // Every enemy the bullet touches, in enemyList order; resolution skips the ones already killed
+                enemyGrid.query(sceneGraph.location[i], sceneGraph.collider_dimension[i], out.candidates);
+                out.enemyBoxes.clear();
+                for (int j : out.candidates)
+                    out.enemyBoxes.push(enemyList.location[j], enemyList.collider_dimension[j]);
+
+                aabbOverlapMasks(sceneGraph.location[i], sceneGraph.collider_dimension[i], out.enemyBoxes, out.hitMasks);
+                for (size_t k = 0; k < out.candidates.size(); k++) {
+                    if (out.hitMasks[k / 32] & (1u << (k % 32)))
+                        out.enemyHits.push_back(Contact{ BULLET_HIT_ENEMY, (int)i, out.candidates[k] });
+                }
+            }
+            else {
+                // === Check if enemy bullets hit the player ===
+                float distToPlayer = glm::length(sceneGraph.location[i] - cam_pos);
+                if (distToPlayer < sceneGraph.collider_dimension[i] / 2.0f)
+                    out.playerHits.push_back(Contact{ BULLET_HIT_PLAYER, (int)i, -1 });
+            }
+        }
+
+        // Moving objects against obstacles
+        out.obstacleHits.clear();
+        obstacleTree.queryBatch(out.movers, &sceneGraph.location[0], &sceneGraph.collider_dimension[0], out.obstacleHits);
+        for (const std::pair<int, int>& hit : out.obstacleHits) {
+            int obstacle = sceneGraph.find(obstacleHandles[hit.second]);
+            if (obstacle >= 0)
+                out.overlaps.push_back(Contact{ OVERLAP, hit.first, obstacle });
+        }
+    });
+
+    contacts.clear();
+    for (size_t c = 0; c < chunks; c++)
+        contacts.insert(contacts.end(), contactChunkOutputs[c].overlaps.begin(), contactChunkOutputs[c].overlaps.end());
+    for (size_t c = 0; c < chunks; c++)
+        contacts.insert(contacts.end(), contactChunkOutputs[c].enemyHits.begin(), contactChunkOutputs[c].enemyHits.end());
+    for (size_t c = 0; c < chunks; c++)
+        contacts.insert(contacts.end(), contactChunkOutputs[c].playerHits.begin(), contactChunkOutputs[c].playerHits.end());
+}
+
+void World::damagePlayer(int logType, const char* message) {
+    playerHealth -= 10;
+    playerHealth = std::max(0, playerHealth);  // clamp to 0
+    if (eventLog)
+        eventLog->log(logType, "%s%d", message, playerHealth);
+
+    if (playerHealth <= 0) {
+        gameOver = true;
+        if (eventLog)
+            eventLog->log(LOG_GAME_RESULT, "Game Over! You lost!");
+    }
+}
+
+// Applies the contacts in order; state changed by an earlier contact is rechecked here, not at detection
+void World::resolveContacts(const std::vector<Contact>& found) {
+    for (const Contact& c : found) {
+        switch (c.type) {
+        case OVERLAP:
+            sceneGraph.isCollided[c.a] = true;
+            sceneGraph.isCollided[c.b] = true;
+            break;
+
+        case BULLET_HIT_ENEMY:
+            if (!enemyList.isAlive[c.b]) break;  // another bullet got there first
+            sceneGraph.isAlive[c.a] = false;
+            enemyList.isAlive[c.b] = false;
+            sceneGraph.isCollided[c.a] = true;
+            enemyList.isCollided[c.b] = true;
+            playerScore += 20;
+            if (eventLog)
+                eventLog->log(LOG_BULLET_HIT_ENEMY, "Bullet hit enemy!");
+            break;
+
+        case BULLET_HIT_PLAYER:
+            sceneGraph.isAlive[c.a] = false;
+            if (!gameOver && !gameWon)
+                damagePlayer(LOG_ENEMY_BULLET_HIT_PLAYER, "Hit by enemy bullet! Health: ");
+            break;
+
+        case ENEMY_HIT_PLAYER:
+            // Enemies that reach the player hurt them and die
+            if (!gameOver && !gameWon && playerHealth > 0) {
+                enemyList.isAlive[c.a] = false;
+                damagePlayer(LOG_ENEMY_HIT_PLAYER, "Player hit! Health: ");
+            }
+            break;
+        }
+    }
+}
+
+void World::checkCollisions() {
+    detectContacts();
+    resolveContacts(contacts);
+}
+
+
+// Bullets fly along their direction until their life span runs out
+void World::moveSceneGraph() {
+    for (const TimedEvent& e : dueEvents) {
+        if (e.kind != BULLET_EXPIRY) continue;
+        int i = sceneGraph.find(e.target);
+        if (i >= 0)
+            sceneGraph.isAlive[i] = false;
+    }
+
+    for (size_t i = 0; i < sceneGraph.size(); i++) {
+        if (sceneGraph.life_span[i] > 0 && sceneGraph.isAlive[i]) {
+            sceneGraph.location[i] += ((GLfloat)simTickMs) * sceneGraph.velocity[i] * glm::normalize(sceneGraph.moving_direction[i]);
+            sceneGraph.living_time[i] += simTickMs;
+        }
+    }
+}
+
+void World::updateEnemies() {
+    size_t chunks = (enemyList.size() + enemyChunkSize - 1) / enemyChunkSize;
+    if (enemyChunkOutputs.size() < chunks)
+        enemyChunkOutputs.resize(chunks);
+
+    // Movement and the contact test only touch the enemy's own entries, so chunks run on any core
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    enemyFlow.update(glm::vec2(cam_pos));
+    parallelFor(enemyList.size(), enemyChunkSize, [this](size_t begin, size_t end, unsigned) {
+        EnemyChunkOutput& out = enemyChunkOutputs[begin / enemyChunkSize];
+        out.contacts.clear();
+        out.lod = LodStats();
+
+        for (size_t i = begin; i < end; i++) {
+            if (!enemyList.isAlive[i]) continue;
+            if (simTime < enemyList.nextUpdateTime[i]) {
+                out.lod.skipped[enemyList.updateBand[i]]++;
+                continue;
+            }
+            int elapsed = simTime - enemyList.lastUpdateTime[i];  // one tick, or several for far enemies
+            enemyList.lastUpdateTime[i] = simTime;
+
+            // Follow the flow field around obstacles; head straight for the player once in their cell or off the field
+            glm::vec2 flow = enemyFlow.direction(glm::vec2(enemyList.location[i]));
+            if (flow.x == 0.0f && flow.y == 0.0f) {
+                enemyList.moving_direction[i] = glm::normalize(cam_pos - enemyList.location[i]);
+                enemyList.location[i] += enemyList.moving_direction[i] * enemyList.velocity[i] * (GLfloat)elapsed;
+            }
+            else {
+                GLfloat step = enemyList.velocity[i] * (GLfloat)elapsed;
+                enemyList.moving_direction[i] = glm::vec3(flow, 0.0f);
+                enemyList.location[i] += enemyList.moving_direction[i] * step;
+                // Close in on the player's height at the same pace
+                enemyList.location[i].z += glm::clamp(cam_pos.z - enemyList.location[i].z, -step, step);
+            }
+
+            // Check collision with player
+            float dist = glm::length(cam_pos - enemyList.location[i]);
+            if (dist < enemyList.collider_dimension[i] / 2.0f)
+                out.contacts.push_back(Contact{ ENEMY_HIT_PLAYER, (int)i, -1 });
+
+            // Schedule the next update by how far away the enemy ended up
+            int band = pickUpdateBand(dist);
+            int interval = updateBands[band].interval;
+            int tick = simTime / simTickMs;
+            enemyList.nextUpdateTime[i] = simTime + simTickMs * (interval - (tick + enemyList.handleOf(i).slot) % interval);
+            enemyList.updateBand[i] = (uint8_t)band;
+            out.lod.updated[band]++;
+        }
+    });
+    for (size_t c = 0; c < chunks; c++) {
+        for (int b = 0; b < maxUpdateBands; b++) {
+            lodStats.updated[b] += enemyChunkOutputs[c].lod.updated[b];
+            lodStats.skipped[b] += enemyChunkOutputs[c].lod.skipped[b];
+        }
+    }
+    simStats.movementMs += elapsedMs(start);
+
+    // === ENEMY SHOOTING ===
+    // Only the enemies whose cooldown ran out this tick; fired in enemyList order
+    start = std::chrono::steady_clock::now();
+    dueShooters.clear();
+    for (const TimedEvent& e : dueEvents) {
+        if (e.kind != ENEMY_FIRE) continue;
+        int i = enemyList.find(e.target);
+        if (i < 0 || !enemyList.isAlive[i]) continue;
+
+        // Enemies that sat this tick out fire on their next update instead
+        if (enemyList.lastUpdateTime[i] != simTime)
+            scheduleAt(enemyList.nextUpdateTime[i], ENEMY_FIRE, e.target);
+        else
+            dueShooters.push_back(i);
+    }
+    std::sort(dueShooters.begin(), dueShooters.end());
+
+    for (int i : dueShooters) {
+        addBullet(makeBullet(enemyList.location[i], glm::normalize(cam_pos - enemyList.location[i]), 0.006f, 1));  // Enemy
+        enemyList.lastShotTime[i] = simTime;
+        scheduleAt(simTime + enemyShootCooldown + 1, ENEMY_FIRE, enemyList.handleOf(i));
+    }
+    simStats.shootingMs += elapsedMs(start);
+
+    // Contacts found while moving go through the same resolution as the ones from checkCollisions()
+    start = std::chrono::steady_clock::now();
+    contacts.clear();
+    for (size_t c = 0; c < chunks; c++)
+        contacts.insert(contacts.end(), enemyChunkOutputs[c].contacts.begin(), enemyChunkOutputs[c].contacts.end());
+    resolveContacts(contacts);
+    simStats.collisionMs += elapsedMs(start);
+}
+
+void World::updateSceneGraph() {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    checkCollisions();
+    simStats.collisionMs += elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    moveSceneGraph();
+    simStats.movementMs += elapsedMs(start);
+
+    updateEnemies();
+
+    // Reclaim dead bullets and enemies so the stores (and every loop above) only hold live entities
+    start = std::chrono::steady_clock::now();
+    sceneGraph.reclaimDead();
+    enemyList.reclaimDead();
+    simStats.reclaimMs += elapsedMs(start);
+}
+
+void World::keyboard(unsigned char key, float frameMs)
+{
+    if (gameWon || gameOver) return;  // freeze controls
+
+    if (key == 'a')
+    {
+        //Moving camera along opposit direction of side vector
+        cam_pos += side_vector * travel_speed * frameMs / 1000.0f;
+    }
+    if (key == 'd')
+    {
+        //Moving camera along side vector
+        cam_pos -= side_vector * travel_speed * frameMs / 1000.0f;
+    }
+    if (key == 'w')
+    {
+        //Moving camera along forward vector. To be more realistic, we use X=V.T equation in physics
+        cam_pos += forward_vector * travel_speed * frameMs / 1000.0f;
+    }
+    if (key == 's')
+    {
+        //Moving camera along backward (negative forward) vector. To be more realistic, we use X=V.T equation in physics
+        cam_pos -= forward_vector * travel_speed * frameMs / 1000.0f;
+    }
+
+    //Added on Nov. 21 2021 by: Alireza Moghaddam
+    if (key == 'f')
+    {
+        //Create a bullet
+        addBullet(makeBullet(cam_pos, looking_dir_vector, 0.01f, 0));  // Player
+    }
+}
+
+//Controlling Pitch with vertical mouse movement
+void World::mouse(int x, int y) {
+    const glm::vec3 unit_z_vector = glm::vec3(0, 0, 1);
+    int delta_x = x - x0;
+    forward_vector = glm::rotate(forward_vector, -delta_x * mouse_sensitivity, unit_z_vector);
+    looking_dir_vector = glm::rotate(looking_dir_vector, -delta_x * mouse_sensitivity, unit_z_vector);
+    side_vector = glm::rotate(side_vector, -delta_x * mouse_sensitivity, unit_z_vector);
+    up_vector = glm::rotate(up_vector, -delta_x * mouse_sensitivity, unit_z_vector);
+    x0 = x;
+
+    int delta_y = y - y_0;
+    glm::vec3 tmp_look = glm::rotate(looking_dir_vector, delta_y * mouse_sensitivity, side_vector);
+    if (glm::dot(tmp_look, forward_vector) > 0) {
+        looking_dir_vector = tmp_look;
+        up_vector = glm::rotate(up_vector, delta_y * mouse_sensitivity, side_vector);
+    }
+    y_0 = y;
+}
+
+void World::simulateTick() {
+    sceneGraph.storePreviousLocations();
+    enemyList.storePreviousLocations();
+    simTime += simTickMs;
+
+    if (!gameOver && !gameWon && winTime > 0 && simTime >= winTime) {
+        gameWon = true;
+        if (eventLog)
+            eventLog->log(LOG_GAME_RESULT, "You Win!");
+    }
+
+    dueEvents.clear();
+    timers.advance(simTime / simTickMs, dueEvents);
+
+    // Spawning stops for good once the game is decided, so the spawn timer is simply not re-armed
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (const TimedEvent& e : dueEvents) {
+        if (e.kind == ENEMY_SPAWN && !gameOver && !gameWon) {
+            spawnEnemy();
+            spawnInterval = std::max(500.0f, spawnInterval - 50.0f);
+            scheduleNextSpawn();
+        }
+    }
+    simStats.spawnMs += elapsedMs(start);
+
+    updateSceneGraph();
+}
+
+void World::initScene()
+{
+    timers.reset(simTime / simTickMs);
+    scheduleNextSpawn();
+
+    //Normalizing all vectors
+    up_vector = glm::normalize(up_vector);
+    forward_vector = glm::normalize(forward_vector);
+    looking_dir_vector = glm::normalize(looking_dir_vector);
+    side_vector = glm::normalize(side_vector);
+
+    //Randomizing obstacles and adding them to the GameScene
+    obstacle_data.resize(numObstacles);
+    obstacleHandles.clear();
+    for (int i = 0; i < numObstacles; i++)
+    {
+        obstacle_data[i][0] = rng.uniform(-obstacleArea, obstacleArea); //X
+        obstacle_data[i][1] = rng.uniform(-obstacleArea, obstacleArea); //Y
+        obstacle_data[i][2] = rng.uniform(0.1f, 10.0f); //Scale
+
+        GameObject go;
+        go.location = glm::vec3(obstacle_data[i][0], obstacle_data[i][1], 0);
+        go.rotation = glm::vec3(0, 0, 0);
+        go.scale = glm::vec3(obstacle_data[i][2], obstacle_data[i][2], obstacle_data[i][2]);
+        go.collider_dimension = go.scale.x;
+        go.isAlive = true;
+        go.living_time = 0;
+        go.isCollided = false;
+        go.velocity = 0;
+        go.type = OBSTACLE;
+        go.moving_direction = glm::vec3(0, 0, 0);
+        go.life_span = -1;
+        go.lastUpdateTime = simTime;
+        go.textureID = 0;
+        go.lastShotTime = 0;
+        go.owner = 0;
+        obstacleHandles.push_back(sceneGraph.spawn(go));
+    }
+    buildObstacleIndex();
+}
+
+// The obstacle tree and the flow field only depend on obstacle_data, so snapshots rebuild them through here too
+void World::buildObstacleIndex()
+{
+    obstacleTree.clear();
+    for (size_t i = 0; i < obstacle_data.size(); i++)
+        obstacleTree.insert((int)i, glm::vec3(obstacle_data[i][0], obstacle_data[i][1], 0), obstacle_data[i][2]);
+    obstacleTree.build();
+
+    // Obstacles grow by half an enemy so the ones following the field do not clip the corners
+    float flowExtent = obstacleArea + flowFieldMargin;
+    enemyFlow.setBounds(glm::vec2(-flowExtent), glm::vec2(flowExtent));
+    for (size_t i = 0; i < obstacle_data.size(); i++)
+        enemyFlow.block(glm::vec2(obstacle_data[i][0], obstacle_data[i][1]), obstacle_data[i][2] / 2 + 0.45f);
+}
+
+// FNV-1a over the raw bytes of the gameplay arrays and the match scalars. Texture ids are left out,
+// they depend on the GL context the match ran in, not on how it went
+struct StateHash {
+    uint64_t hash = 14695981039346656037ULL;
+
+    void bytes(const void* data, size_t size) {
+        const unsigned char* p = (const unsigned char*)data;
+        for (size_t i = 0; i < size; i++)
+            hash = (hash ^ p[i]) * 1099511628211ULL;
+    }
+
+    template <typename T>
+    void operator()(const std::vector<T>& v) {
+        uint64_t count = v.size();
+        bytes(&count, sizeof(count));
+        if (!v.empty())
+            bytes(v.data(), v.size() * sizeof(T));
+    }
+
+    void store(const EntityStore& s) {
+        (*this)(s.location);
+        (*this)(s.moving_direction);
+        (*this)(s.velocity);
+        (*this)(s.collider_dimension);
+        (*this)(s.isAlive);
+        (*this)(s.isCollided);
+        (*this)(s.type);
+        (*this)(s.living_time);
+        (*this)(s.life_span);
+        (*this)(s.lastUpdateTime);
+        (*this)(s.lastShotTime);
+        (*this)(s.owner);
+    }
+};
+
+uint64_t World::checksum() const
+{
+    StateHash state;
+    state.store(sceneGraph);
+    state.store(enemyList);
+    uint64_t rngState, rngIncrement;
+    rng.getState(rngState, rngIncrement);
+    state.bytes(&rngState, sizeof(rngState));
+    state.bytes(&simTime, sizeof(simTime));
+    state.bytes(&playerHealth, sizeof(playerHealth));
+    state.bytes(&playerScore, sizeof(playerScore));
+    state.bytes(&cam_pos, sizeof(cam_pos));
+    state.bytes(&looking_dir_vector, sizeof(looking_dir_vector));
+    return state.hash;
+}
@@ -0,0 +1,232 @@
+﻿#pragma once
+#include "vgl.h"
+#include "glm\glm.hpp"
+#include "EntityStore.h"
+#include "SpatialGrid.h"
+#include "StaticBVH.h"
+#include "AabbKernel.h"
+#include "FlowField.h"
+#include "TimingWheel.h"
+#include <vector>
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+class JobSystem;
+class Logger;
+
+/*************************************************
+
+	One independent game world
+
+	Everything a match changes lives here: the
+	entity stores, the player, the camera, the
+	timers, the obstacles and the random number
+	generator. Two worlds share nothing, so one
+	process can run many of them side by side,
+	each on its own thread.
+
+	A world spreads its own work over jobs when
+	it is given a JobSystem and runs everything
+	on the calling thread when it is not. Game
+	events go to eventLog when one is set.
+
+**************************************************/
+
+const int simTickMs = 10;               // every simulation tick advances exactly this many milliseconds
+const int enemyShootCooldown = 2000;    // milliseconds between shots
+const int maxUpdateBands = 8;
+
+double elapsedMs(std::chrono::steady_clock::time_point since);
+bool aabbOverlap(glm::vec3 a, GLfloat sizeA, glm::vec3 b, GLfloat sizeB);
+
+// Accumulated wall-clock cost of each simulation phase
+struct SimStats {
+    double spawnMs = 0;
+    double movementMs = 0;
+    double shootingMs = 0;
+    double collisionMs = 0;
+    double reclaimMs = 0;
+};
+
+// === Update-rate LOD ===
+// Enemies far from the player only update every few ticks and catch up on the time they sat out.
+// Each enemy is staggered by its slot id, so a band's updates spread evenly over its interval
+struct UpdateBand {
+    float minDistance;  // from cam_pos
+    int interval;       // ticks between updates
+};
+
+struct LodStats {
+    long long updated[maxUpdateBands] = {};
+    long long skipped[maxUpdateBands] = {};
+};
+
+// === Timers ===
+// Every deadline in the game lives in one timing wheel that advances one slot per simulation tick
+enum TimedEvent_Kind {
+    BULLET_EXPIRY,
+    ENEMY_FIRE,
+    ENEMY_SPAWN
+};
+
+struct TimedEvent {
+    int kind;
+    EntityHandle target; // bullet or enemy the event belongs to
+};
+
+// === Contacts ===
+// Detection only reads the stores and records what touched what; resolveContacts() then applies
+// damage, score and despawns in one ordered pass. Indices stay valid until reclaimDead() at the end of the tick
+enum Contact_Type {
+    OVERLAP,            // a, b: two sceneGraph entries overlapping
+    BULLET_HIT_ENEMY,   // a: player bullet in sceneGraph, b: enemyList
+    BULLET_HIT_PLAYER,  // a: enemy bullet in sceneGraph
+    ENEMY_HIT_PLAYER    // a: enemyList
+};
+
+struct Contact {
+    int type;
+    int a;
+    int b;
+};
+
+// Per-chunk results of the parallel detection pass, one list per contact type.
+// Chunks are merged in order, so contacts come out as the serial scan would find them
+struct ContactChunkOutput {
+    std::vector<Contact> overlaps;
+    std::vector<Contact> enemyHits;
+    std::vector<Contact> playerHits;
+    std::vector<int> candidates;  // broadphase scratch
+    AabbBoxes enemyBoxes;  // the candidates of one bullet, packed for the narrowphase kernel
+    std::vector<uint32_t> hitMasks;
+    std::vector<int> movers;  // live non-obstacles of the chunk, queried against the obstacle tree in one batch
+    std::vector<std::pair<int, int>> obstacleHits;
+};
+
+// Per-chunk results of the parallel enemy pass. Chunks are merged in order, so the
+// player hits come out exactly as a serial loop over enemyList would produce them
+struct EnemyChunkOutput {
+    std::vector<Contact> contacts;  // enemies touching the player
+    LodStats lod;
+};
+
+// Deterministic per-world random numbers; a world seeded the same way replays the same match on any thread
+class WorldRandom {
+    uint64_t state = 0;
+    uint64_t increment = 1;
+public:
+    void seed(uint64_t s);
+
+    // uniform over all 32-bit values
+    uint32_t next();
+
+    // uniform in [a, b]
+    float uniform(float a, float b) { return a + (float)(next() * (1.0 / 4294967295.0)) * (b - a); }
+
+    // raw generator state, so a snapshot resumes the exact same sequence
+    void getState(uint64_t& s, uint64_t& inc) const { s = state; inc = increment; }
+    void setState(uint64_t s, uint64_t inc) { state = s; increment = inc | 1; }
+};
+
+class World {
+public:
+    World();
+
+    // === Match state ===
+    EntityStore sceneGraph; // dead entries are reclaimed at the end of every update
+    EntityStore enemyList;
+    float spawnInterval = 3000.0f;
+    int playerHealth = 100;
+    bool gameWon = false;
+    bool gameOver = false;
+    int winTime = 30000;                // surviving this many simulated ms wins; 0 = play on forever (a setting, not saved)
+    int playerScore = 0;
+    int simTime = 0;                    // simulated milliseconds since start
+    WorldRandom rng;
+
+    // === Camera / player ===
+    glm::vec3 cam_pos = glm::vec3(0.0f, 0.0f, 0.8f);
+    glm::vec3 forward_vector = glm::vec3(1, 1, 0);
+    glm::vec3 looking_dir_vector = glm::vec3(1, 1, 0);
+    glm::vec3 up_vector = glm::vec3(0, 0, 1);
+    glm::vec3 side_vector = glm::cross(up_vector, forward_vector);
+    int x0 = 0, y_0 = 0;
+    float travel_speed = 300.0f;
+    float mouse_sensitivity = 0.01f;
+
+    // === Obstacles ===
+    int numObstacles = 20;
+    float obstacleArea = 50.0f; // obstacles are scattered over [-obstacleArea, obstacleArea] in x and y
+    std::vector<std::array<float, 3>> obstacle_data;
+
+    // === Settings ===
+    std::vector<UpdateBand> updateBands = { { 0.0f, 1 }, { 25.0f, 2 }, { 50.0f, 4 }, { 100.0f, 8 } }; // sorted by distance; the first applies at any distance below the second
+    GLuint enemyTexture = 0;
+    GLuint bulletTexture = 0;
+    JobSystem* jobs = nullptr;      // runs the per-chunk passes; everything stays on the calling thread without one
+    Logger* eventLog = nullptr;     // hit and result messages; silent without one
+
+    // === Statistics ===
+    SimStats simStats;
+    LodStats lodStats;
+
+    // Scatters the obstacles and arms the spawn timer; call once the settings above are final
+    void initScene();
+
+    // Advances the game by exactly one fixed step of simTickMs
+    void simulateTick();
+
+    // Player input; frameMs scales camera movement
+    void keyboard(unsigned char key, float frameMs);
+    void mouse(int x, int y);
+
+    // Binary snapshot of the whole match (WorldSnapshot.cpp). Loading replaces this world's state and keeps its
+    // textures, job system and log; both print why and return false on failure, and a failed load leaves the world as it was
+    bool saveSnapshot(const char* path) const;
+    bool loadSnapshot(const char* path);
+
+    // Hash of the whole match state; two runs that end on the same value took the same course
+    uint64_t checksum() const;
+
+    GameObject makeEnemy(glm::vec3 position);
+    GameObject makeBullet(glm::vec3 position, glm::vec3 direction, GLfloat velocity, int owner);
+    void addBullet(const GameObject& bullet);
+    void addEnemy(const GameObject& enemy);
+
+private:
+    SpatialGrid sceneGrid; // broadphase for moving sceneGraph objects vs each other
+    SpatialGrid enemyGrid; // broadphase for player bullets vs enemyList
+
+    // Obstacles never move, so they get a tree built once in initScene() instead of going through the grid every tick
+    StaticBVH obstacleTree; // indices into obstacleHandles
+    std::vector<EntityHandle> obstacleHandles;
+
+    // Enemies route around the obstacles by following this field toward the player's cell
+    FlowField enemyFlow;
+
+    TimingWheel<TimedEvent> timers;
+    std::vector<TimedEvent> dueEvents; // events that came due this tick
+    std::vector<int> dueShooters;
+
+    std::vector<ContactChunkOutput> contactChunkOutputs;
+    std::vector<EnemyChunkOutput> enemyChunkOutputs;
+    std::vector<Contact> contacts;
+
+    template <typename F>
+    void parallelFor(size_t count, size_t grain, const F& job);
+
+    void scheduleAt(int dueSimTime, int kind, EntityHandle target);
+    void scheduleNextSpawn();
+    void buildObstacleIndex();
+    void spawnEnemy();
+    int pickUpdateBand(float distance) const;
+
+    void detectContacts();
+    void damagePlayer(int logType, const char* message);
+    void resolveContacts(const std::vector<Contact>& found);
+    void checkCollisions();
+    void moveSceneGraph();
+    void updateEnemies();
+    void updateSceneGraph();
+};
@@ -0,0 +1,357 @@
+﻿#include "World.h"
+#include "MappedFile.h"
+#include <cstring>
+#include <iostream>
+
+// === Snapshot file layout ===
+// header | section table | sections, each starting on a 16-byte boundary.
+// Every section is one raw array copied straight out of memory, in the order saveSnapshot() lists them;
+// loading checks the table and copies each array back in one go, nothing is parsed per entity.
+// The file is only meant to be read back by the same build on the same kind of machine, so it is
+// stored in native byte order and the loader rejects any other.
+
+const char snapshotMagic[8] = { 'W', '3', 'D', 'S', 'N', 'A', 'P', 0 };
+const uint32_t snapshotVersion = 1;         // bump whenever a section is added, removed or changes layout
+const uint32_t snapshotByteOrder = 0x01020304;
+const size_t snapshotAlignment = 16;
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t sectionCount;
+    uint32_t reserved;
+    uint64_t fileSize;
+};
+static_assert(sizeof(SnapshotHeader) == 32, "snapshot header layout changed");
+
+struct SnapshotSection {
+    uint32_t id;            // position in the section list, so a shuffled file is caught
+    uint32_t elementSize;
+    uint64_t count;
+    uint64_t offset;        // from the start of the file
+};
+static_assert(sizeof(SnapshotSection) == 24, "snapshot section layout changed");
+
+// Every scalar of the match, in one fixed-layout record
+struct SnapshotWorldState {
+    int32_t simTime;
+    float spawnInterval;
+    int32_t playerHealth;
+    int32_t playerScore;
+    uint8_t gameWon;
+    uint8_t gameOver;
+    uint8_t padding[2];
+    int32_t numObstacles;
+    float obstacleArea;
+    float cam_pos[3];
+    float forward_vector[3];
+    float looking_dir_vector[3];
+    float up_vector[3];
+    float side_vector[3];
+    int32_t x0, y_0;
+    float travel_speed;
+    float mouse_sensitivity;
+    uint64_t rngState;
+    uint64_t rngIncrement;
+    int64_t timerTick;
+    int64_t lodUpdated[maxUpdateBands];
+    int64_t lodSkipped[maxUpdateBands];
+};
+static_assert(sizeof(SnapshotWorldState) == 256, "snapshot world state layout changed");
+
+// One pending timer, filed back exactly where it was so events keep firing in the same order
+struct SnapshotTimer {
+    int32_t place;
+    int32_t kind;
+    int64_t due;
+    int32_t slot;
+    uint32_t generation;
+};
+static_assert(sizeof(SnapshotTimer) == 24, "snapshot timer layout changed");
+
+static void storeVec3(float out[3], glm::vec3 v) {
+    out[0] = v.x;
+    out[1] = v.y;
+    out[2] = v.z;
+}
+
+static glm::vec3 loadVec3(const float in[3]) {
+    return glm::vec3(in[0], in[1], in[2]);
+}
+
+// A timer must sit somewhere the wheel has and point at a slot its kind's store has
+static bool timerIsValid(const SnapshotTimer& t, const EntityStore& scene, const EntityStore& enemies) {
+    typedef TimingWheel<TimedEvent> Wheel;
+    if (t.place != Wheel::filedOverdue && t.place != Wheel::filedOverflow && (t.place < 0 || t.place >= Wheel::filedSlots))
+        return false;
+    switch (t.kind) {
+    case BULLET_EXPIRY: return t.slot >= 0 && (size_t)t.slot < scene.slotCount();
+    case ENEMY_FIRE: return t.slot >= 0 && (size_t)t.slot < enemies.slotCount();
+    case ENEMY_SPAWN: return t.slot == -1;
+    default: return false;
+    }
+}
+
+// Bands must be sorted by distance with every interval at least one tick, or the LOD pass divides by zero
+static bool bandsAreValid(const std::vector<UpdateBand>& bands) {
+    for (size_t b = 0; b < bands.size(); b++) {
+        if (bands[b].interval < 1 || !(bands[b].minDistance >= 0.0f))
+            return false;
+        if (b > 0 && bands[b].minDistance < bands[b - 1].minDistance)
+            return false;
+    }
+    return true;
+}
+
+static size_t alignUp(size_t n) {
+    return (n + snapshotAlignment - 1) / snapshotAlignment * snapshotAlignment;
+}
+
+// Collects the arrays to save, in section order
+struct SnapshotWriter {
+    struct Block {
+        const void* data;
+        size_t elementSize;
+        size_t count;
+    };
+    std::vector<Block> blocks;
+
+    template <typename T>
+    void operator()(const std::vector<T>& v) { blocks.push_back(Block{ v.data(), sizeof(T), v.size() }); }
+
+    template <typename T>
+    void single(const T& value) { blocks.push_back(Block{ &value, sizeof(T), 1 }); }
+};
+
+// Hands the arrays back in the same order, checking each against the section table
+struct SnapshotReader {
+    const unsigned char* base;
+    size_t fileSize;
+    const SnapshotSection* sections;
+    uint32_t sectionCount;
+    uint32_t next = 0;
+    bool ok = true;
+
+    const SnapshotSection* take(size_t elementSize) {
+        if (!ok || next >= sectionCount) {
+            ok = false;
+            return nullptr;
+        }
+        const SnapshotSection& s = sections[next];
+        if (s.id != next || s.elementSize != elementSize || s.offset % snapshotAlignment != 0 || s.offset > fileSize || s.count > (fileSize - s.offset) / elementSize) {
+            ok = false;
+            return nullptr;
+        }
+        next++;
+        return &s;
+    }
+
+    template <typename T>
+    void operator()(std::vector<T>& v) {
+        const SnapshotSection* s = take(sizeof(T));
+        if (s == nullptr)
+            return;
+        // sections start 16-byte aligned, so the mapping can be read as T directly; assign() copies without zero-filling first
+        const T* first = reinterpret_cast<const T*>(base + s->offset);
+        v.assign(first, first + s->count);
+    }
+
+    template <typename T>
+    void single(T& value) {
+        const SnapshotSection* s = take(sizeof(T));
+        if (s == nullptr)
+            return;
+        if (s->count != 1) {
+            ok = false;
+            return;
+        }
+        std::memcpy(&value, base + s->offset, sizeof(T));
+    }
+};
+
+bool World::saveSnapshot(const char* path) const
+{
+    SnapshotWorldState state = {};
+    state.simTime = simTime;
+    state.spawnInterval = spawnInterval;
+    state.playerHealth = playerHealth;
+    state.playerScore = playerScore;
+    state.gameWon = gameWon;
+    state.gameOver = gameOver;
+    state.numObstacles = numObstacles;
+    state.obstacleArea = obstacleArea;
+    storeVec3(state.cam_pos, cam_pos);
+    storeVec3(state.forward_vector, forward_vector);
+    storeVec3(state.looking_dir_vector, looking_dir_vector);
+    storeVec3(state.up_vector, up_vector);
+    storeVec3(state.side_vector, side_vector);
+    state.x0 = x0;
+    state.y_0 = y_0;
+    state.travel_speed = travel_speed;
+    state.mouse_sensitivity = mouse_sensitivity;
+    rng.getState(state.rngState, state.rngIncrement);
+    state.timerTick = timers.now();
+    for (int b = 0; b < maxUpdateBands; b++) {
+        state.lodUpdated[b] = lodStats.updated[b];
+        state.lodSkipped[b] = lodStats.skipped[b];
+    }
+
+    std::vector<SnapshotTimer> pendingTimers;
+    pendingTimers.reserve(timers.pending());
+    timers.visitPending([&](int place, long long due, const TimedEvent& e) {
+        pendingTimers.push_back(SnapshotTimer{ place, e.kind, due, e.target.slot, e.target.generation });
+    });
+
+    SnapshotWriter writer;
+    writer.single(state);
+    sceneGraph.visitArrays(writer);
+    enemyList.visitArrays(writer);
+    writer(obstacle_data);
+    writer(obstacleHandles);
+    writer(updateBands);
+    writer(pendingTimers);
+
+    std::vector<SnapshotSection> table(writer.blocks.size());
+    size_t offset = alignUp(sizeof(SnapshotHeader) + table.size() * sizeof(SnapshotSection));
+    for (size_t i = 0; i < table.size(); i++) {
+        table[i].id = (uint32_t)i;
+        table[i].elementSize = (uint32_t)writer.blocks[i].elementSize;
+        table[i].count = writer.blocks[i].count;
+        table[i].offset = offset;
+        offset = alignUp(offset + writer.blocks[i].elementSize * writer.blocks[i].count);
+    }
+
+    MappedFile file;
+    if (!file.createWrite(path, offset)) {
+        std::cout << "Failed to create snapshot " << path << std::endl;
+        return false;
+    }
+    SnapshotHeader header = {};
+    std::memcpy(header.magic, snapshotMagic, sizeof(header.magic));
+    header.version = snapshotVersion;
+    header.byteOrder = snapshotByteOrder;
+    header.sectionCount = (uint32_t)table.size();
+    header.fileSize = offset;
+
+    unsigned char* out = file.data();
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + sizeof(header), table.data(), table.size() * sizeof(SnapshotSection));
+    for (size_t i = 0; i < table.size(); i++) {
+        if (writer.blocks[i].count > 0)
+            std::memcpy(out + table[i].offset, writer.blocks[i].data, writer.blocks[i].elementSize * writer.blocks[i].count);
+    }
+    file.close();
+    return true;
+}
+
+bool World::loadSnapshot(const char* path)
+{
+    MappedFile file;
+    if (!file.openRead(path)) {
+        std::cout << "Failed to open snapshot " << path << std::endl;
+        return false;
+    }
+
+    SnapshotHeader header;
+    if (file.size() < sizeof(header)) {
+        std::cout << path << ": not a snapshot" << std::endl;
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, snapshotMagic, sizeof(header.magic)) != 0 || header.byteOrder != snapshotByteOrder) {
+        std::cout << path << ": not a snapshot, or written on a machine with another byte order" << std::endl;
+        return false;
+    }
+    if (header.version != snapshotVersion) {
+        std::cout << path << ": snapshot version " << header.version << ", expected " << snapshotVersion << std::endl;
+        return false;
+    }
+    if (header.fileSize != file.size() || header.sectionCount > (file.size() - sizeof(header)) / sizeof(SnapshotSection)) {
+        std::cout << path << ": snapshot is truncated" << std::endl;
+        return false;
+    }
+
+    // Everything lands in temporaries first, so a damaged file leaves this world untouched
+    std::vector<SnapshotSection> table(header.sectionCount);
+    std::memcpy(table.data(), file.data() + sizeof(header), table.size() * sizeof(SnapshotSection));
+    SnapshotReader reader{ file.data(), file.size(), table.data(), header.sectionCount };
+
+    SnapshotWorldState state;
+    EntityStore loadedScene, loadedEnemies;
+    std::vector<std::array<float, 3>> loadedObstacles;
+    std::vector<EntityHandle> loadedObstacleHandles;
+    std::vector<UpdateBand> loadedBands;
+    std::vector<SnapshotTimer> pendingTimers;
+    reader.single(state);
+    loadedScene.visitArrays(reader);
+    loadedEnemies.visitArrays(reader);
+    reader(loadedObstacles);
+    reader(loadedObstacleHandles);
+    reader(loadedBands);
+    reader(pendingTimers);
+    if (!reader.ok || reader.next != header.sectionCount || loadedObstacles.size() != loadedObstacleHandles.size() ||
+        loadedBands.empty() || loadedBands.size() > (size_t)maxUpdateBands) {
+        std::cout << path << ": snapshot sections do not match this build" << std::endl;
+        return false;
+    }
+
+    // The arrays come in exactly as stored, so check they describe stores and timers the simulation can walk
+    bool consistent = loadedScene.isConsistent() && loadedEnemies.isConsistent() && bandsAreValid(loadedBands);
+    for (size_t i = 0; consistent && i < loadedEnemies.size(); i++)
+        consistent = loadedEnemies.updateBand[i] < loadedBands.size();
+    for (size_t i = 0; consistent && i < loadedObstacleHandles.size(); i++)
+        consistent = loadedScene.find(loadedObstacleHandles[i]) >= 0;
+    for (size_t i = 0; consistent && i < pendingTimers.size(); i++)
+        consistent = timerIsValid(pendingTimers[i], loadedScene, loadedEnemies);
+    if (!consistent) {
+        std::cout << path << ": snapshot is damaged" << std::endl;
+        return false;
+    }
+    file.close();
+
+    sceneGraph = std::move(loadedScene);
+    enemyList = std::move(loadedEnemies);
+    obstacle_data = std::move(loadedObstacles);
+    obstacleHandles = std::move(loadedObstacleHandles);
+    updateBands = std::move(loadedBands);
+
+    simTime = state.simTime;
+    spawnInterval = state.spawnInterval;
+    playerHealth = state.playerHealth;
+    playerScore = state.playerScore;
+    gameWon = state.gameWon != 0;
+    gameOver = state.gameOver != 0;
+    numObstacles = state.numObstacles;
+    obstacleArea = state.obstacleArea;
+    cam_pos = loadVec3(state.cam_pos);
+    forward_vector = loadVec3(state.forward_vector);
+    looking_dir_vector = loadVec3(state.looking_dir_vector);
+    up_vector = loadVec3(state.up_vector);
+    side_vector = loadVec3(state.side_vector);
+    x0 = state.x0;
+    y_0 = state.y_0;
+    travel_speed = state.travel_speed;
+    mouse_sensitivity = state.mouse_sensitivity;
+    rng.setState(state.rngState, state.rngIncrement);
+    for (int b = 0; b < maxUpdateBands; b++) {
+        lodStats.updated[b] = state.lodUpdated[b];
+        lodStats.skipped[b] = state.lodSkipped[b];
+    }
+
+    timers.reset(state.timerTick);
+    for (const SnapshotTimer& t : pendingTimers)
+        timers.file(t.place, t.due, TimedEvent{ t.kind, EntityHandle{ t.slot, t.generation } });
+
+    // Texture ids belong to the GL context that saved them; hand out this world's instead
+    for (size_t i = 0; i < sceneGraph.size(); i++) {
+        if (sceneGraph.type[i] == BULLET)
+            sceneGraph.textureID[i] = bulletTexture;
+    }
+    for (size_t j = 0; j < enemyList.size(); j++)
+        enemyList.textureID[j] = enemyTexture;
+
+    // Derived from the obstacles, so rebuilt rather than stored; the grids are rebuilt every tick anyway
+    buildObstacleIndex();
+    return true;
+}
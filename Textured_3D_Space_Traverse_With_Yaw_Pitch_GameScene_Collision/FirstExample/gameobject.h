@@ -1,9 +1,30 @@
 #pragma once
 #include <string>
 #include "glm\glm.hpp"
+
+//compact type tag, one per concrete class; collision responses are looked up by a pair of these
+enum ObjectTag : unsigned char
+{
+	TAG_NONE,
+	TAG_PLAYER,
+	TAG_TANK,
+	TAG_BULLET,
+	TAG_COUNT
+};
+
+//refers to an object in one of the GameScene pools; resolves to nullptr once the object is erased
+struct ObjectHandle
+{
+	ObjectTag type = TAG_NONE;	//which pool
+	unsigned int index = 0;
+	unsigned int generation = 0;
+};
+
 class GameObject
 {
 	std::string goType;
+	ObjectTag tag = TAG_NONE;
+	ObjectHandle handle;
 	glm::vec3 goLocation = glm::vec3(0, 0, 0);
 	glm::vec3 goDirection = glm::vec3(0, 0, 0);
 	//exam code added
@@ -30,6 +51,22 @@ public:
 	float retYOff();
 	void setAlive(bool a);
 	bool getAlive();
+	void setTag(ObjectTag t)
+	{
+		tag = t;
+	}
+	ObjectTag getTag()
+	{
+		return tag;
+	}
+	void setHandle(ObjectHandle h)
+	{
+		handle = h;
+	}
+	ObjectHandle getHandle()
+	{
+		return handle;
+	}
 	void setRot(bool r)
 	{
 		noRot = r;
@@ -1,11 +1,18 @@
 #version 430 core
 
 in vec2 texCoord;
+flat in int entry;
 out vec4 fColor;
 
-uniform sampler2D texture;
+uniform sampler2D flatTexture;
+uniform sampler2DArray textureArray;	//see TextureArray
+uniform vec4 entryRects[16];			//offset and size within the layer
+uniform int entryLayers[16];
 
 void main()
 {
-	fColor = texture2D(texture, texCoord);
+	if (entry < 0)
+		fColor = texture(flatTexture, texCoord);
+	else
+		fColor = texture(textureArray, vec3(entryRects[entry].xy + fract(texCoord) * entryRects[entry].zw, entryLayers[entry]));
 }
\ No newline at end of file
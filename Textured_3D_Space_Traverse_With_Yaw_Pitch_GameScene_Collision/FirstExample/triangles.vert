@@ -1,15 +1,22 @@
 #version 430 core
 layout(location = 0) in vec4 vPosition;
 layout(location = 1) in vec2 vTexCoord;
+layout(location = 2) in vec3 instancePosition;	//per instance, see InstancedBatches
+layout(location = 3) in vec3 instanceScale;
+layout(location = 4) in int instanceEntry;		//into the texture array table, -1 for the bound 2D texture
 
 uniform mat4 model_matrix;
 uniform mat4 camera_matrix;
 uniform mat4 projection_matrix;
+uniform bool instanced;	//place with the instance attributes instead of model_matrix
 
 out vec2 texCoord;
+flat out int entry;
 
 void main()
 {
-	gl_Position = projection_matrix * camera_matrix * model_matrix * vPosition;
+	vec4 worldPosition = instanced ? vec4(vPosition.xyz * instanceScale + instancePosition, 1.0) : model_matrix * vPosition;
+	gl_Position = projection_matrix * camera_matrix * worldPosition;
 	texCoord = vTexCoord;
+	entry = instanced ? instanceEntry : -1;
 }